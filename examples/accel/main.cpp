@@ -6,8 +6,10 @@
  */
 #define CTRL_LOG_LEVEL CTRL_LOG_LEVEL_INFO
 #include <ctrl/accel_designer.h>
+#include <ctrl/csv_writer.h>
 
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -15,23 +17,53 @@
 void printCsv(const std::string &filebase, const ctrl::AccelDesigner &ad) {
   ctrl_logi << ad << std::endl;
   const float Ts = 1e-4f;
-  std::ofstream of;
   const auto ticks = ad.getTimeStamp();
   float t = 0;
   for (size_t i = 0; i < ticks.size(); ++i) {
-    of = std::ofstream(filebase + "_" + std::to_string(i) + ".csv");
+    std::ofstream of(filebase + "_" + std::to_string(i) + ".csv");
+    ctrl::CsvWriter csv(of);
     while (t + Ts < ticks[i]) {
-      of << t;
-      of << "," << ad.j(t);
-      of << "," << ad.a(t);
-      of << "," << ad.v(t);
-      of << "," << ad.x(t);
-      of << std::endl;
+      csv.row({t, ad.j(t), ad.a(t), ad.v(t), ad.x(t)});
       t += Ts;
     }
   }
 }
 
+void measurementCsv(const ctrl::AccelDesigner &ad) {
+  const char *path = "accel_csv_bench.csv";
+  const int n = 200000;
+  const float Ts = ad.t_end() / n;
+  const auto rate = [&](const std::chrono::steady_clock::time_point &ts) {
+    const auto te = std::chrono::steady_clock::now();
+    const auto dur =
+        std::chrono::duration_cast<std::chrono::microseconds>(te - ts);
+    return double(n) * 1e6 / double(dur.count() + 1);
+  };
+  {
+    std::ofstream of(path);
+    const auto ts = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+      const float t = Ts * float(i);
+      of << t << "," << ad.j(t) << "," << ad.a(t) << "," << ad.v(t) << ","
+         << ad.x(t) << std::endl;
+    }
+    std::cout << "ostream:   " << rate(ts) << " [rows/s]" << std::endl;
+  }
+  {
+    std::ofstream of(path);
+    const auto ts = std::chrono::steady_clock::now();
+    {
+      ctrl::CsvWriter csv(of);
+      for (int i = 0; i < n; ++i) {
+        const float t = Ts * float(i);
+        csv.row({t, ad.j(t), ad.a(t), ad.v(t), ad.x(t)});
+      }
+    }
+    std::cout << "CsvWriter: " << rate(ts) << " [rows/s]" << std::endl;
+  }
+  std::remove(path);
+}
+
 void measurement() {
   ctrl::AccelDesigner ad;
   const std::vector<std::vector<float>> params = {
@@ -68,6 +100,7 @@ int main() {
 
   /* time measurement */
   measurement();
+  measurementCsv(ad);
 
   return 0;
 }
@@ -5,6 +5,7 @@
  * @date 2020-05-04
  */
 #include <ctrl/accel_designer.h>
+#include <ctrl/binary_log.h>
 
 #include <chrono>
 #include <fstream>
@@ -14,11 +15,16 @@
 ctrl::AccelDesigner ad;
 ctrl::AccelCurve ac;
 std::ofstream of("continuous.csv");
+ctrl::CsvWriter csv(of);
+std::ofstream of_bin("continuous.bin", std::ios::binary);
+ctrl::BinaryLogWriter bin(of_bin, {"t", "j", "a", "v", "x"});
 
 void test(const float jm, const float am, const float vm, const float vs,
           const float vt, const float d, const float xs, const float ts) {
   ad.reset(jm, am, vm, vs, vt, d, xs, ts);
-  ad.printCsv(of);
+  ad.printCsv(csv);
+  for (float t = ad.t_0(); t < ad.t_end(); t += 1e-3f)
+    bin.push({t, ad.j(t), ad.a(t), ad.v(t), ad.x(t)});
   // std::cout << ad << std::endl;
 }
 
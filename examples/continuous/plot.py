@@ -2,6 +2,10 @@
 import numpy as np
 import matplotlib.pyplot as plt
 import argparse
+import os
+import sys
+sys.path.append(os.path.join(os.path.dirname(__file__), '..'))
+import ctrl_log  # noqa: E402
 
 parser = argparse.ArgumentParser()
 parser.add_argument("--file")
@@ -14,7 +18,10 @@ filename = './continuous.csv'
 if args.file:
     filename = args.file
 
-raw = np.loadtxt(filename, delimiter=',')
+if filename.endswith('.bin'):
+    raw = ctrl_log.load_array(filename)
+else:
+    raw = np.loadtxt(filename, delimiter=',')
 t = raw[:, 0]
 v = raw[:, 1:5]
 
@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# ============================================================================ #
+# reader of the binary log written by ctrl::BinaryLogWriter (binary_log.h)
+# the format is little-endian; binary_log.h refuses to build on other targets
+# ============================================================================ #
+import os
+import numpy as np
+
+HEADER = np.dtype([
+    ('magic', 'S8'),
+    ('version', '<u4'),
+    ('columns', '<u4'),
+    ('rows', '<u8'),
+    ('data_offset', '<u4'),
+    ('name_size', '<u4'),
+    ('reserved', 'V32'),
+])
+
+
+def load(filename):
+    """Map a binary log into memory without reading it.
+
+    Returns a structured np.memmap whose fields are the column names,
+    e.g. log['t'] is a strided view of the time column.
+    """
+    header = np.fromfile(filename, dtype=HEADER, count=1)
+    if header.size != 1 or header['magic'][0] != b'CTRLLOG' or \
+            header['version'][0] != 1:
+        raise ValueError(f'{filename} is not a binary log')
+    h = header[0]
+    columns, name_size = int(h['columns']), int(h['name_size'])
+    data_offset = int(h['data_offset'])
+    names = np.fromfile(filename, dtype=f'S{name_size}', count=columns,
+                        offset=HEADER.itemsize)
+    names = [n.decode() for n in names]
+    # the row count may be 0 or too large if the writer was interrupted
+    available = (os.path.getsize(filename) - data_offset) // (4 * columns)
+    rows = min(int(h['rows']), available) if h['rows'] else available
+    dtype = np.dtype([(n, '<f4') for n in names])
+    return np.memmap(filename, dtype=dtype, mode='r', offset=data_offset,
+                     shape=(rows,))
+
+
+def load_array(filename):
+    """Map a binary log as an (N, columns) float32 array."""
+    log = load(filename)
+    return log.view('<f4').reshape(len(log), len(log.dtype.names))
@@ -1,9 +1,11 @@
 #include <fstream>
 
 #include <ctrl/accel_designer.h>
+#include <ctrl/csv_writer.h>
 #include <ctrl/feedback_controller.h>
 
-std::ofstream csv("main.csv");
+std::ofstream of("main.csv");
+ctrl::CsvWriter csv(of);
 
 int main(void) {
   /* Feedforward Model and Feedback Gain */
@@ -27,18 +29,7 @@ int main(void) {
     /* apply control input u here */
     /* csv output */
     const auto bd = feedback_controller.getBreakdown();
-    csv << t;
-    csv << "," << r;
-    csv << "," << y;
-    csv << "," << dr;
-    csv << "," << dy;
-    csv << "," << u;
-    csv << "," << bd.ff;
-    csv << "," << bd.fb;
-    csv << "," << bd.fbp;
-    csv << "," << bd.fbi;
-    csv << "," << bd.fbd;
-    csv << std::endl;
+    csv.row({t, r, y, dr, dy, u, bd.ff, bd.fb, bd.fbp, bd.fbi, bd.fbd});
   }
 
   return 0;
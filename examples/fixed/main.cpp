@@ -0,0 +1,225 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief comparison of float and fixed-point controllers
+ * @date 2026-10-16
+ *
+ * 記録した走行データ (目標状態と推定状態の列) を float 版と固定小数点版の
+ * 制御器に同じ順に与え，出力の誤差と 1 回あたりの実行時間を比較する．
+ * 引数に trajectory 例の出力 csv を与えると，それを目標状態として用いる．
+ */
+#include <ctrl/feedback_controller.h>
+#include <ctrl/fixed_point.h>
+#include <ctrl/slalom.h>
+#include <ctrl/straight.h>
+#include <ctrl/trajectory_tracker.h>
+#include <ctrl/trajectory_tracker_fixed.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ctrl;
+
+/**
+ * @brief a tick of a recorded run
+ */
+struct Sample {
+  State ref;   /*< reference state */
+  Pose est_q;  /*< estimated pose */
+  Polar est_v; /*< estimated velocity */
+  Polar est_a; /*< estimated acceleration */
+};
+
+/**
+ * @brief add estimation noise to a reference state
+ */
+Sample makeSample(const State &ref, std::mt19937 &mt) {
+  std::normal_distribution<float> nd(0, 1);
+  Sample s;
+  s.ref = ref;
+  s.est_q = ref.q + Pose(0.2f * nd(mt), 0.2f * nd(mt), 2e-3f * nd(mt));
+  const auto v = std::sqrt(ref.dq.x * ref.dq.x + ref.dq.y * ref.dq.y);
+  const auto a = (ref.dq.x * ref.ddq.x + ref.dq.y * ref.ddq.y) /
+                 std::max(v, 1.0f); //< tangential acceleration
+  s.est_v = Polar(v + 5 * nd(mt), ref.dq.th + 0.02f * nd(mt));
+  s.est_a = Polar(a + 50 * nd(mt), ref.ddq.th + 0.2f * nd(mt));
+  return s;
+}
+
+/**
+ * @brief record a run of straight - slalom - straight
+ */
+std::vector<Sample> recordRun(std::mt19937 &mt) {
+  const float Ts = TrajectoryTracker::Ts;
+  const float v_slalom = 600;
+  std::vector<Sample> run;
+  State s;
+  /* accelerate */
+  straight::Trajectory st;
+  st.reset(240000, 6000, 1200, 0, v_slalom, 90 * 3);
+  for (float t = 0; t < st.t_end(); t += Ts)
+    st.update(s, t), run.push_back(makeSample(s, mt));
+  /* turn */
+  const auto shape = slalom::Shape(Pose(90, 90, M_PI / 2), 80);
+  slalom::Trajectory sl(shape);
+  sl.reset(v_slalom);
+  s.q = Pose(90 * 3 + shape.straight_prev, 0, 0);
+  for (float t = 0; t < sl.getTimeCurve(); t += Ts)
+    sl.update(s, t, Ts), run.push_back(makeSample(s, mt));
+  /* decelerate along y */
+  const auto q_end = s.q;
+  st.reset(240000, 6000, 1200, v_slalom, 0, 90 * 2);
+  for (float t = 0; t < st.t_end(); t += Ts) {
+    State sy;
+    st.update(sy, t);
+    s.q = Pose(q_end.x, q_end.y + sy.q.x, M_PI / 2);
+    s.dq = Pose(0, sy.dq.x, 0), s.ddq = Pose(0, sy.ddq.x, 0);
+    s.dddq = Pose(0, sy.dddq.x, 0);
+    run.push_back(makeSample(s, mt));
+  }
+  return run;
+}
+
+/**
+ * @brief load reference states from the csv of the trajectory example
+ */
+std::vector<Sample> loadRun(const std::string &path, std::mt19937 &mt) {
+  std::vector<Sample> run;
+  std::ifstream ifs(path);
+  for (std::string line; std::getline(ifs, line);) {
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream iss(line);
+    float t;
+    State s;
+    iss >> t >> s.dddq.th >> s.ddq.th >> s.dq.th >> s.q.th;
+    iss >> s.dddq.x >> s.ddq.x >> s.dq.x >> s.q.x;
+    iss >> s.dddq.y >> s.ddq.y >> s.dq.y >> s.q.y;
+    if (iss)
+      run.push_back(makeSample(s, mt));
+  }
+  return run;
+}
+
+/**
+ * @brief per-output error and timing of a pair of controllers
+ */
+template <std::size_t N> struct Comparison {
+  std::array<float, N> max_error{};
+  std::array<float, N> max_value{};
+  double ns_float = 0;
+  double ns_fixed = 0;
+
+  void add(const std::array<float, N> &a, const std::array<float, N> &b) {
+    for (std::size_t i = 0; i < N; ++i) {
+      max_error[i] = std::max(max_error[i], std::abs(a[i] - b[i]));
+      max_value[i] = std::max(max_value[i], std::abs(a[i]));
+    }
+  }
+  void print(const std::string &name,
+             const std::array<const char *, N> &labels) const {
+    std::cout << "==== " << name << std::endl;
+    for (std::size_t i = 0; i < N; ++i)
+      std::cout << std::setw(4) << labels[i] << "  max error: " << std::setw(12)
+                << max_error[i] << "  (max |value|: " << max_value[i] << ")"
+                << std::endl;
+    std::cout << "float: " << ns_float << " ns/update, fixed: " << ns_fixed
+              << " ns/update" << std::endl;
+  }
+};
+
+/**
+ * @brief measure the mean execution time of f over the run
+ */
+template <typename F>
+double measure(const std::vector<Sample> &run, const int repeat, F f) {
+  const auto ts = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; ++r)
+    for (const auto &s : run)
+      f(s);
+  const auto te = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(te - ts).count() / repeat /
+         run.size();
+}
+
+void compareTrajectoryTracker(const std::vector<Sample> &run,
+                              const int repeat) {
+  const TrajectoryTracker::Gain gain;
+  TrajectoryTracker tt(gain);
+  TrajectoryTrackerFixed<16> tf(gain);
+  Comparison<4> c;
+  tt.reset(), tf.reset();
+  for (const auto &s : run) {
+    const auto a = tt.update(s.est_q, s.est_v, s.est_a, s.ref);
+    const auto b = tf.update(s.est_q, s.est_v, s.est_a, s.ref);
+    c.add({{a.v, a.w, a.dv, a.dw}}, {{b.v, b.w, b.dv, b.dw}});
+  }
+  volatile float sink;
+  c.ns_float = measure(run, repeat, [&](const Sample &s) {
+    sink = tt.update(s.est_q, s.est_v, s.est_a, s.ref).v;
+  });
+  c.ns_fixed = measure(run, repeat, [&](const Sample &s) {
+    sink = tf.update(s.est_q, s.est_v, s.est_a, s.ref).v;
+  });
+  (void)sink;
+  c.print("TrajectoryTracker [mm]", {{"v", "w", "dv", "dw"}});
+}
+
+void compareFeedbackController(const std::vector<Sample> &run,
+                               const int repeat) {
+  const float Ts = TrajectoryTracker::Ts;
+  FeedbackController<float> ff({1.2f, 0.03f}, {0.1f, 10.0f, 0.001f});
+  const Q16 Ts_fixed = Ts; //< convert once, not in every update
+  FeedbackController<Q16> fx({1.2f, 0.03f}, {0.1f, 10.0f, 0.001f});
+  Comparison<1> c;
+  /* velocity control in [m/s] to fit in Q15.16 */
+  const auto r = [](const Sample &s) {
+    return std::sqrt(s.ref.dq.x * s.ref.dq.x + s.ref.dq.y * s.ref.dq.y) / 1e3f;
+  };
+  for (const auto &s : run) {
+    const auto a = ff.update(r(s), s.est_v.tra / 1e3f, 0, s.est_a.tra / 1e3f,
+                             Ts);
+    const auto b = fx.update(r(s), s.est_v.tra / 1e3f, 0, s.est_a.tra / 1e3f,
+                             Ts);
+    c.add({{a}}, {{b.toFloat()}});
+  }
+  /* convert the inputs in advance to time only the control law */
+  std::vector<std::array<float, 3>> in_float;
+  std::vector<std::array<Q16, 3>> in_fixed;
+  for (const auto &s : run) {
+    in_float.push_back({{r(s), s.est_v.tra / 1e3f, s.est_a.tra / 1e3f}});
+    in_fixed.push_back({{r(s), s.est_v.tra / 1e3f, s.est_a.tra / 1e3f}});
+  }
+  volatile float sink;
+  std::size_t i = 0;
+  c.ns_float = measure(run, repeat, [&](const Sample &) {
+    const auto &v = in_float[i++ % in_float.size()];
+    sink = ff.update(v[0], v[1], 0, v[2], Ts);
+  });
+  c.ns_fixed = measure(run, repeat, [&](const Sample &) {
+    const auto &v = in_fixed[i++ % in_fixed.size()];
+    sink = fx.update(v[0], v[1], Q16(), v[2], Ts_fixed).toFloat();
+  });
+  (void)sink;
+  c.print("FeedbackController [m/s]", {{"u"}});
+}
+
+int main(int argc, char *argv[]) {
+  /* fixed seed to reproduce the noise */
+  std::mt19937 mt{1};
+  const auto run = argc > 1 ? loadRun(argv[1], mt) : recordRun(mt);
+  std::cout << "samples: " << run.size() << std::endl;
+  if (run.empty())
+    return 1;
+  const int repeat = 200;
+  compareTrajectoryTracker(run, repeat);
+  compareFeedbackController(run, repeat);
+  return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief identification of the feedforward model from a log
+ * @date 2026-10-16
+ *
+ * feedback 例と同じ列 (t,r,y,dr,dy,u,ff,fb,fbp,fbi,fbd) の csv を1行ずつ
+ * 読みながら1次モデルを同定する．記録全体は読み込まないので，長い記録にも
+ * 使える．引数がない場合は，既知の1次系を模擬した記録で同定する．
+ */
+#include <ctrl/accel_designer.h>
+#include <ctrl/feedback_controller.h>
+#include <ctrl/model_identifier.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace ctrl;
+
+/**
+ * @brief stream a csv of the feedback example into the identifier
+ */
+bool pushCsv(const char *path, ModelIdentifier &mi) {
+  FILE *fp = std::fopen(path, "r");
+  if (!fp)
+    return false;
+  char line[512];
+  while (std::fgets(line, sizeof(line), fp)) {
+    float col[6];
+    char *p = line;
+    int n = 0;
+    for (; n < 6; ++n) {
+      char *end;
+      col[n] = std::strtof(p, &end);
+      if (end == p)
+        break;
+      p = end + (*end == ',');
+    }
+    if (n == 6)
+      mi.push(col[5], col[2]); //< u, y
+  }
+  std::fclose(fp);
+  return true;
+}
+
+/**
+ * @brief simulate a velocity control of a first-order plant
+ */
+void pushSimulation(const FeedbackController<float>::Model &plant,
+                    const float Ts, ModelIdentifier &mi) {
+  /* controller with a rough model */
+  FeedbackController<float> fc({1, 0}, {0.5f, 20, 0});
+  std::mt19937 mt{1};
+  std::normal_distribution<float> disturbance(0, 0.02f);
+  float y = 0;
+  for (int i = 0; i < 20; ++i) {
+    const AccelDesigner ad(240, 9, 1.2f, 0, 0, 0.72f);
+    for (int k = 0; k * Ts < ad.t_end() + 0.2f; ++k) {
+      const float t = k * Ts;
+      const float u = fc.update(ad.v(t), y, ad.a(t), 0, Ts);
+      mi.push(u, y);
+      /* discretized plant with an input disturbance */
+      const float a = std::exp(-Ts / plant.T1);
+      y = a * y + plant.K1 * (1 - a) * (u + disturbance(mt));
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const float Ts = 1e-3f;
+  const FeedbackController<float>::Model plant = {5.8f, 0.36f};
+  ModelIdentifier mi;
+  const auto ts = std::chrono::steady_clock::now();
+  if (argc > 1) {
+    if (!pushCsv(argv[1], mi)) {
+      std::cerr << "failed to open " << argv[1] << std::endl;
+      return 1;
+    }
+  } else {
+    pushSimulation(plant, Ts, mi);
+    std::cout << "plant:\tK1: " << plant.K1 << "\tT1: " << plant.T1
+              << std::endl;
+  }
+  const auto te = std::chrono::steady_clock::now();
+  const auto sec = std::chrono::duration<double>(te - ts).count();
+  std::cout << "samples: " << mi.size() << " (" << mi.size() / sec
+            << " samples/s)" << std::endl;
+  FeedbackController<float>::Model model;
+  if (!mi.estimate(model, Ts)) {
+    std::cerr << "the log is not informative enough" << std::endl;
+    return 1;
+  }
+  std::cout << "model:\tK1: " << model.K1 << "\tT1: " << model.T1
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief compile a maze run from straights and slaloms into one trajectory
+ * @date 2026-10-16
+ */
+#include <ctrl/csv_writer.h>
+#include <ctrl/path.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+using namespace ctrl;
+
+static const float pi = M_PI;
+static const float cell = 90; //< 区画の長さ [mm]
+
+int main(void) {
+  const slalom::Shape F90(Pose(90, 90, pi / 2), 70);
+  const slalom::Shape F45(Pose(90, 45, pi / 4), 30);
+  const slalom::Shape FV90(Pose(45 * std::sqrt(2.0f), 45 * std::sqrt(2.0f),
+                                pi / 2),
+                           48);
+  using path::Motion;
+  const std::vector<Motion> motions = {
+      Motion::straight(3 * cell), Motion::turn(F90),
+      Motion::straight(1 * cell), Motion::turn(F90, true),
+      Motion::turn(F45),          Motion::turn(FV90, true),
+      Motion::turn(F45, true),    Motion::straight(4 * cell),
+  };
+
+  /* compile */
+  path::Trajectory tr;
+  const auto ts = std::chrono::steady_clock::now();
+  const bool feasible = tr.reset(motions, 240000, 3600, 2400);
+  const auto te = std::chrono::steady_clock::now();
+  std::cout << "Compile Time: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(te - ts)
+                   .count()
+            << " [us]" << std::endl;
+  if (!feasible)
+    std::cout << "Turn velocity exceeded!" << std::endl;
+  std::cout << "Segments: " << tr.getSegments().size()
+            << "\tKnots: " << tr.getKnots().size() << std::endl;
+  std::cout << "End: " << tr.getPoseEnd() << "\tt_end: " << tr.t_end()
+            << std::endl;
+
+  /* csv output */
+  std::ofstream of("path.csv");
+  CsvWriter csv(of);
+  const float Ts = 1e-3f;
+  for (float t = tr.t_start(); t < tr.t_end(); t += Ts) {
+    const auto s = tr.stateAt(t);
+    csv.row({t, s.q.x, s.q.y, s.q.th, s.dq.x, s.dq.y, s.dq.th});
+  }
+
+  /* lookup time */
+  const int n = 1000000;
+  float sum = 0;
+  const auto ls = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; ++i)
+    sum += tr.stateAt(tr.t_end() * float(i) / n).q.x;
+  const auto le = std::chrono::steady_clock::now();
+  const auto dur =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(le - ls);
+  std::cout << "Average stateAt Time: " << dur.count() / n << " [ns]"
+            << " (" << sum << ")" << std::endl;
+
+  return 0;
+}
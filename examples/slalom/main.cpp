@@ -4,6 +4,7 @@
  * @brief slalom trajectory generation example
  * @date 2020-05-04
  */
+#include <ctrl/csv_writer.h>
 #include <ctrl/slalom.h>
 
 #include <cmath>
@@ -21,23 +22,10 @@ void printCsv(const std::string &filebase, const slalom::Shape &ss,
   State s;
   st.reset(v, th_start, ss.straight_prev / v);
   const float Ts = st.getTimeCurve() * 1e-5f;
-  const auto printCSV = [](std::ostream &os, const float t, const State &s) {
-    os << t;
-    os << "," << s.dddq.th;
-    os << "," << s.ddq.th;
-    os << "," << s.dq.th;
-    os << "," << s.q.th;
-    os << "," << s.dddq.x;
-    os << "," << s.ddq.x;
-    os << "," << s.dq.x;
-    os << "," << s.q.x;
-    os << "," << s.dddq.y;
-    os << "," << s.ddq.y;
-    os << "," << s.dq.y;
-    os << "," << s.q.y;
-    os << std::endl;
+  const auto printCSV = [](CsvWriter &csv, const float t, const State &s) {
+    csv.row({t, s.dddq.th, s.ddq.th, s.dq.th, s.q.th, s.dddq.x, s.ddq.x,
+             s.dq.x, s.q.x, s.dddq.y, s.ddq.y, s.dq.y, s.q.y});
   };
-  std::ofstream of;
   const std::vector<float> ticks = {{
       st.getAccelDesigner().t_0(),
       st.getAccelDesigner().t_1(),
@@ -47,9 +35,10 @@ void printCsv(const std::string &filebase, const slalom::Shape &ss,
   }};
   float t = 0;
   for (size_t i = 0; i < ticks.size(); ++i) {
-    of = std::ofstream(filebase + "_" + std::to_string(i) + ".csv");
+    std::ofstream of(filebase + "_" + std::to_string(i) + ".csv");
+    CsvWriter csv(of);
     while (t < ticks[i])
-      st.update(s, t, Ts, 2e-5f), printCSV(of, t, s), t += Ts;
+      st.update(s, t, Ts, 2e-5f), printCSV(csv, t, s), t += Ts;
   }
 }
 
@@ -4,6 +4,7 @@
  * @brief trajectory tracking
  * @date 2020-05-04
  */
+#include <ctrl/csv_writer.h>
 #include <ctrl/straight.h>
 #include <ctrl/trajectory_tracker.h>
 
@@ -13,30 +14,15 @@
 #include <iostream>
 
 std::ofstream of("trajectory.csv");
-std::ostream &os = of;
+ctrl::CsvWriter csv(of);
 
 using namespace ctrl;
 
 void printCsv(const float t, const State &s,
               const TrajectoryTracker::Result &ref) {
-  os << t;
-  os << "," << s.dddq.th;
-  os << "," << s.ddq.th;
-  os << "," << s.dq.th;
-  os << "," << s.q.th;
-  os << "," << s.dddq.x;
-  os << "," << s.ddq.x;
-  os << "," << s.dq.x;
-  os << "," << s.q.x;
-  os << "," << s.dddq.y;
-  os << "," << s.ddq.y;
-  os << "," << s.dq.y;
-  os << "," << s.q.y;
-  os << "," << ref.v;
-  os << "," << ref.w;
-  os << "," << ref.dv;
-  os << "," << ref.dw;
-  os << std::endl;
+  csv.row({t, s.dddq.th, s.ddq.th, s.dq.th, s.q.th, s.dddq.x, s.ddq.x, s.dq.x,
+           s.q.x, s.dddq.y, s.ddq.y, s.dq.y, s.q.y, ref.v, ref.w, ref.dv,
+           ref.dw});
 }
 
 int main(void) {
@@ -0,0 +1,489 @@
+/**
+ * @file main.cpp
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief worst-case execution time (WCET) profiling of control-loop functions
+ * @date 2026-10-16
+ *
+ * 制御周期の割り込みで呼ばれる関数を，境界条件を狙ったパラメータと乱数の
+ * パラメータで繰り返し呼び出し，1回ごとの実行サイクル数をヒストグラムとして
+ * 記録する．最大値だけでなく p99, p99.9 と，最悪値を出した分岐を表示する．
+ */
+#include <ctrl/accel_designer.h>
+#include <ctrl/accel_replanner.h>
+#include <ctrl/feedback_controller.h>
+#include <ctrl/slalom.h>
+#include <ctrl/trajectory_tracker.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+using namespace ctrl;
+
+/**
+ * @brief read the cycle counter (rdtsc on x86, clock_gettime otherwise)
+ */
+static inline uint64_t readCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_lfence(); //< wait for the preceding instructions
+  const uint64_t c = __rdtsc();
+  _mm_lfence(); //< keep the following instructions after the read
+  return c;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000u + uint64_t(ts.tv_nsec);
+#endif
+}
+#if defined(__x86_64__) || defined(__i386__)
+static const char *const counter_unit = "cycles";
+#else
+static const char *const counter_unit = "ns";
+#endif
+
+/* sink to keep the measured results alive */
+static volatile float sink;
+
+/**
+ * @brief per-call execution time recorder
+ */
+class Profiler {
+public:
+  /**
+   * @brief histogram and worst case of a branch
+   */
+  struct Record {
+    std::map<uint64_t, std::size_t> histogram; /*< count for each value */
+    std::size_t count = 0;
+    uint64_t max = 0;
+    std::string worst; /*< parameters of the worst call */
+  };
+
+public:
+  Profiler(const std::string &name) : name(name) {}
+  /**
+   * @brief measure a call of f
+   *
+   * @param branch label of the branch the call takes
+   * @param f function to measure
+   * @param describe returns the parameters; called only when a new max occurs
+   */
+  template <typename F, typename D>
+  void measure(const std::string &branch, F f, D describe) {
+    const auto ts = readCounter();
+    f();
+    const auto te = readCounter();
+    const auto dur = te - ts;
+    const auto c = dur > overhead ? dur - overhead : 0;
+    auto &r = records[branch];
+    r.histogram[c]++;
+    r.count++;
+    if (c > r.max || r.count == 1)
+      r.max = c, r.worst = describe();
+  }
+  /**
+   * @brief print a summary
+   */
+  void report(std::ostream &os) const {
+    Record all;
+    std::string worst_branch;
+    for (const auto &[branch, r] : records) {
+      for (const auto &[c, n] : r.histogram)
+        all.histogram[c] += n;
+      all.count += r.count;
+      if (r.max >= all.max)
+        all.max = r.max, all.worst = r.worst, worst_branch = branch;
+    }
+    os << "==== " << name << " [" << counter_unit << "]" << std::endl;
+    printStatistics(os, "(all)", all);
+    for (const auto &[branch, r] : records)
+      printStatistics(os, branch, r);
+    os << "worst branch: " << worst_branch << std::endl;
+    os << "worst call:   " << all.worst << std::endl;
+    printHistogram(os, all);
+  }
+  /**
+   * @brief write the full histograms in csv (name,branch,value,count)
+   */
+  void writeCsv(std::ostream &os) const {
+    for (const auto &[branch, r] : records)
+      for (const auto &[c, n] : r.histogram)
+        os << name << "," << branch << "," << c << "," << n << "\n";
+  }
+  /**
+   * @brief calibrate the measurement overhead with an empty call
+   */
+  static void calibrate() {
+    overhead = std::numeric_limits<uint64_t>::max();
+    for (int i = 0; i < 100000; ++i) {
+      const auto ts = readCounter();
+      const auto te = readCounter();
+      overhead = std::min(overhead, te - ts);
+    }
+  }
+
+private:
+  std::string name;
+  std::map<std::string, Record> records;
+  static uint64_t overhead;
+
+  static uint64_t percentile(const Record &r, const double p) {
+    const auto k = std::size_t(std::ceil(p * r.count));
+    std::size_t n = 0;
+    for (const auto &[c, cnt] : r.histogram)
+      if ((n += cnt) >= k)
+        return c;
+    return r.max;
+  }
+  static void printStatistics(std::ostream &os, const std::string &label,
+                              const Record &r) {
+    if (r.count == 0)
+      return;
+    os << std::left << std::setw(40) << label << std::right;
+    os << " n: " << std::setw(8) << r.count;
+    os << " min: " << std::setw(6) << r.histogram.begin()->first;
+    os << " p50: " << std::setw(6) << percentile(r, 0.5);
+    os << " p99: " << std::setw(6) << percentile(r, 0.99);
+    os << " p99.9: " << std::setw(6) << percentile(r, 0.999);
+    os << " max: " << std::setw(8) << r.max << std::endl;
+  }
+  static void printHistogram(std::ostream &os, const Record &r) {
+    /* power-of-two buckets */
+    std::vector<std::size_t> buckets(65, 0);
+    for (const auto &[c, n] : r.histogram) {
+      int b = 0;
+      while ((uint64_t(1) << b) <= c && b < 64)
+        ++b;
+      buckets[b] += n;
+    }
+    const auto peak = *std::max_element(buckets.begin(), buckets.end());
+    for (std::size_t b = 0; b < buckets.size(); ++b) {
+      if (buckets[b] == 0)
+        continue;
+      const auto hi = b == 0 ? 0 : (uint64_t(1) << b) - 1;
+      const auto bar = std::max<std::size_t>(1, 50 * buckets[b] / peak);
+      os << "  <= " << std::setw(8) << hi << " | " << std::setw(9) << buckets[b]
+         << " " << std::string(bar, '#') << std::endl;
+    }
+  }
+};
+uint64_t Profiler::overhead = 0;
+
+/**
+ * @brief label of the regime that AccelCurve::calcReachableVelocityEnd takes
+ */
+std::string classifyReachableVelocityEnd(const float j_max, const float a_max,
+                                         const float vs, const float vt,
+                                         const float d) {
+  const auto tc = a_max / j_max;
+  const auto am = (vt > vs) ? a_max : -a_max;
+  const auto jm = (vt > vs) ? j_max : -j_max;
+  const auto d_triangle = (vs + am * tc / 2) * tc;
+  const auto v_triangle = jm / am * d - vs;
+  if (d * v_triangle > 0 && std::abs(d) > std::abs(d_triangle))
+    return "curve-straight-curve";
+  const auto a = std::abs(vs);
+  const auto b = (d > 0 ? 1 : -1) * jm * d * d;
+  const auto ci_b = 8 * a * a * a / 27 / b + 1.0f / 4;
+  return ci_b >= 0 ? "curve-curve(accel)" : "curve-curve(decel)";
+}
+
+/**
+ * @brief label of the branches that AccelDesigner::reset takes
+ */
+std::string classifyReset(const float jm, const float am, const float vm,
+                          const float vs, const float vt, const float d) {
+  std::string label;
+  auto v_end = vt;
+  const auto dist_min =
+      AccelCurve::calcDistanceFromVelocityStartToEnd(jm, am, vs, vt);
+  if (std::abs(d) < std::abs(dist_min)) {
+    label = "ve!=vt/" + classifyReachableVelocityEnd(jm, am, vs, vt, d);
+    v_end = AccelCurve::calcReachableVelocityEnd(jm, am, vs, vt, d);
+  } else {
+    label = "ve==vt";
+  }
+  const auto v_sat = d > 0 ? std::max({vs, vm, v_end})
+                           : std::min({vs, -vm, v_end});
+  const AccelCurve ac(jm, am, vs, v_sat);
+  const AccelCurve dc(jm, am, v_sat, v_end);
+  const auto d_sum = ac.x_end() + dc.x_end();
+  label += std::abs(d) < std::abs(d_sum) ? " vs->vr->ve" : " vs->vm->ve";
+  return label;
+}
+
+/**
+ * @brief index of the boundary interval that t belongs to
+ */
+template <typename A> std::string classifyTime(const A &ad, const float t) {
+  const auto ts = ad.getTimeStamp();
+  std::size_t i = 0;
+  while (i < ts.size() && ts[i] <= t)
+    ++i;
+  return "segment " + std::to_string(i);
+}
+
+/**
+ * @brief parameters of AccelDesigner::reset
+ */
+struct Constraint {
+  float jm, am, vm, vs, vt, d;
+  std::string str() const {
+    std::stringstream ss;
+    ss << "reset(" << jm << ", " << am << ", " << vm << ", " << vs << ", "
+       << vt << ", " << d << ")";
+    return ss.str();
+  }
+};
+
+/**
+ * @brief adversarial and random constraints
+ */
+std::vector<Constraint> makeConstraints(std::mt19937 &mt, const int n) {
+  std::vector<Constraint> cs = {
+      // jm, am, vm, vs, vt, d
+      {100, 10, 4, 0, 0, 0},          //< zero
+      {100, 10, 4, 0, 2, 4},          //< vs -> vm -> vt
+      {100, 10, 4, 0, 3, 4},          //< vs -> vm -> vt, tm2<0
+      {100, 10, 4, 3, 0, 4},          //< vs -> vm -> vt, tm1<0
+      {100, 10, 8, 0, 2, 4},          //< vs -> vr -> vt
+      {100, 10, 8, 0, 6, 4},          //< vs -> vr -> vt, tm2<0
+      {100, 10, 8, 0, 0.5, 0.2},      //< vs -> vr -> vt, tm1<0, tm2<0
+      {100, 10, 6, 0, 4, 1},          //< ve == vt, tm > 0 just
+      {100, 10, 8, 0, 6, 1},          //< ve != vt, tm > 0, accel
+      {100, 10, 8, 4, 0, 1},          //< ve != vt, tm > 0, decel
+      {100, 10, 4, 0, 4, 0.1},        //< ve != vt, tm < 0, accel
+      {100, 10, 4, 4, 0, 0.1},        //< ve != vt, tm < 0, decel
+      {100, 10, 4, 4, 4, 1e-6f},      //< almost zero distance
+      {100, 10, 4, 1e-6f, 4, 1e-6f},  //< almost zero distance from stop
+      {1e6f, 1e-3f, 4, 0, 4, 1},      //< extreme jerk/accel ratio
+      {1e-3f, 1e6f, 4, 0, 4, 1},      //< extreme accel/jerk ratio
+      {100, 10, 4, 2, -2, 1},         //< velocity reversal
+      {100, 10, 4, -2, 2, 1},         //< start backward
+      {100, 10, 1e-6f, 0, 4, 1},      //< almost zero max velocity
+      {240000, 6000, 1200, 0, 0, 90}, //< single cell of micromouse
+  };
+  /* both directions */
+  for (int i = 0, size = cs.size(); i < size; ++i) {
+    auto c = cs[i];
+    c.vs = -c.vs, c.vt = -c.vt, c.d = -c.d;
+    cs.push_back(c);
+  }
+  /* random */
+  std::uniform_real_distribution<float> j_urd(100, 1000000);
+  std::uniform_real_distribution<float> a_urd(1, 10000);
+  std::uniform_real_distribution<float> v_urd(0, 10000);
+  std::uniform_real_distribution<float> d_urd(-10000, 10000);
+  std::uniform_real_distribution<float> s_urd(-1, 1);
+  for (int i = 0; i < n; ++i) {
+    const auto vs = v_urd(mt) * (s_urd(mt) > -0.8f ? 1 : -1);
+    const auto vt = v_urd(mt) * (s_urd(mt) > -0.8f ? 1 : -1);
+    /* logarithmic distance to hit short distances frequently */
+    const auto d = d_urd(mt) * std::pow(10.0f, -6 * (s_urd(mt) + 1) / 2);
+    cs.push_back({j_urd(mt), a_urd(mt), v_urd(mt), vs, vt, d});
+  }
+  return cs;
+}
+
+/**
+ * @brief TrajectoryTracker with access to the auxiliary state
+ */
+class TrajectoryTrackerProbe : public TrajectoryTracker {
+public:
+  using TrajectoryTracker::TrajectoryTracker;
+  float getXi() const { return xi; }
+};
+
+void profileAccelDesigner(std::ostream &csv, const std::vector<Constraint> &cs,
+                          std::mt19937 &mt) {
+  Profiler p_reset("AccelDesigner::reset");
+  Profiler p_reachable("AccelCurve::calcReachableVelocityEnd");
+  Profiler p_j("AccelDesigner::j");
+  Profiler p_a("AccelDesigner::a");
+  Profiler p_v("AccelDesigner::v");
+  Profiler p_x("AccelDesigner::x");
+  std::uniform_real_distribution<float> r_urd(-0.1f, 1.1f);
+  AccelDesigner ad;
+  for (const auto &c : cs) {
+    p_reset.measure(
+        classifyReset(c.jm, c.am, c.vm, c.vs, c.vt, c.d),
+        [&] { ad.reset(c.jm, c.am, c.vm, c.vs, c.vt, c.d); },
+        [&] { return c.str(); });
+    p_reachable.measure(
+        classifyReachableVelocityEnd(c.jm, c.am, c.vs, c.vt, c.d),
+        [&] {
+          sink = AccelCurve::calcReachableVelocityEnd(c.jm, c.am, c.vs, c.vt,
+                                                      c.d);
+        },
+        [&] { return c.str(); });
+    /* evaluators over the profile and outside of it */
+    for (int i = 0; i < 16; ++i) {
+      const float t = ad.t_end() * r_urd(mt);
+      const auto branch = classifyTime(ad, t);
+      const auto describe = [&] {
+        return c.str() + " t: " + std::to_string(t);
+      };
+      p_j.measure(branch, [&] { sink = ad.j(t); }, describe);
+      p_a.measure(branch, [&] { sink = ad.a(t); }, describe);
+      p_v.measure(branch, [&] { sink = ad.v(t); }, describe);
+      p_x.measure(branch, [&] { sink = ad.x(t); }, describe);
+    }
+  }
+  for (const auto *p : {&p_reset, &p_reachable, &p_j, &p_a, &p_v, &p_x})
+    p->report(std::cout), p->writeCsv(csv);
+}
+
+void profileAccelReplanner(std::ostream &csv, std::mt19937 &mt, const int n) {
+  Profiler p("AccelReplanner::replan");
+  std::uniform_real_distribution<float> v_urd(0, 3000);
+  std::uniform_real_distribution<float> d_urd(1, 3000);
+  std::uniform_real_distribution<float> r_urd(0, 1);
+  const float jm = 240000, am = 6000, vm = 3000;
+  AccelReplanner ar;
+  for (int i = 0; i < n; ++i) {
+    const AccelDesigner ad(jm, am, vm, v_urd(mt), v_urd(mt), d_urd(mt));
+    const float t = ad.t_end() * r_urd(mt);
+    const auto vt = v_urd(mt);
+    /* logarithmic distance to hit short distances frequently */
+    const auto d = d_urd(mt) * std::pow(10.0f, -3 * r_urd(mt));
+    /* branch is determined by a trial run */
+    AccelReplanner probe;
+    probe.replan(jm, am, vm, ad, t, vt, d);
+    p.measure(
+        probe.hasRamp() ? "ramp to zero accel" : "virtual start",
+        [&] { ar.replan(jm, am, vm, ad, t, vt, d); },
+        [&] {
+          std::stringstream ss;
+          ss << ad << " t: " << t << " vt: " << vt << " d: " << d;
+          return ss.str();
+        });
+  }
+  sink = ar.v_end();
+  p.report(std::cout), p.writeCsv(csv);
+}
+
+void profileShape(std::ostream &csv, std::mt19937 &mt, const int n) {
+  Profiler p("slalom::Shape::integrate");
+  const float pi = M_PI;
+  const std::vector<slalom::Shape> shapes = {
+      slalom::Shape(Pose(45, 45, pi / 2), 44),
+      slalom::Shape(Pose(90, 45, pi / 4), 30),
+      slalom::Shape(Pose(45, 90, pi * 3 / 4), 80),
+      slalom::Shape(Pose(0, 90, pi), 90, 24),
+  };
+  std::uniform_real_distribution<float> r_urd(-0.1f, 1.1f);
+  std::uniform_real_distribution<float> v_urd(0, 3000);
+  State s;
+  for (int i = 0; i < n; ++i) {
+    for (const auto &shape : shapes) {
+      slalom::Trajectory st(shape);
+      const auto v = v_urd(mt);
+      st.reset(v);
+      const auto &ad = st.getAccelDesigner();
+      const float t = ad.t_end() * r_urd(mt);
+      const float k_slip = i % 2 ? 1e-5f : 0;
+      const auto branch = classifyTime(ad, t) + (k_slip ? " slip" : "");
+      p.measure(
+          branch, [&] { slalom::Shape::integrate(ad, s, v, t, 1e-3f, k_slip); },
+          [&] {
+            std::stringstream ss;
+            ss << shape.total << " v: " << v << " t: " << t;
+            return ss.str();
+          });
+    }
+  }
+  sink = s.q.x;
+  p.report(std::cout), p.writeCsv(csv);
+}
+
+void profileTrajectoryTracker(std::ostream &csv, std::mt19937 &mt,
+                              const int n) {
+  Profiler p("TrajectoryTracker::update");
+  TrajectoryTrackerProbe tt(TrajectoryTracker::Gain{});
+  std::uniform_real_distribution<float> p_urd(-100, 100);
+  std::uniform_real_distribution<float> th_urd(-M_PI, M_PI);
+  std::uniform_real_distribution<float> v_urd(-3000, 3000);
+  std::uniform_real_distribution<float> xi_urd(-300, 300);
+  for (int i = 0; i < n; ++i) {
+    /* sweep the state around the switching threshold of the control law */
+    const auto xi = i % 4 ? xi_urd(mt) : 0;
+    const Pose est_q(p_urd(mt), p_urd(mt), th_urd(mt));
+    const Polar est_v(v_urd(mt), th_urd(mt));
+    const Polar est_a(v_urd(mt), th_urd(mt));
+    State ref;
+    ref.q = Pose(p_urd(mt), p_urd(mt), th_urd(mt));
+    ref.dq = Pose(v_urd(mt), v_urd(mt), th_urd(mt));
+    ref.ddq = Pose(v_urd(mt), v_urd(mt), th_urd(mt));
+    ref.dddq = Pose(v_urd(mt), v_urd(mt), th_urd(mt));
+    tt.reset(xi);
+    /* branch is determined by the integrated state */
+    TrajectoryTrackerProbe probe = tt;
+    probe.update(est_q, est_v, est_a, ref);
+    const auto xi_next = std::abs(probe.getXi());
+    const auto branch = xi_next < TrajectoryTracker::xi_threshold
+                            ? "low speed law"
+                            : "linearized law";
+    p.measure(
+        branch, [&] { sink = tt.update(est_q, est_v, est_a, ref).v; },
+        [&] {
+          std::stringstream ss;
+          ss << "xi: " << xi << " est_q: " << est_q << " ref.q: " << ref.q;
+          return ss.str();
+        });
+  }
+  p.report(std::cout), p.writeCsv(csv);
+}
+
+void profileFeedbackController(std::ostream &csv, std::mt19937 &mt,
+                               const int n) {
+  Profiler p("FeedbackController<float>::update");
+  Profiler p_fast("FeedbackController<float>::updateFast");
+  FeedbackController<float> fc({1.2f, 0.03f}, {0.1f, 10.0f, 0.001f});
+  std::uniform_real_distribution<float> urd(-3000, 3000);
+  for (int i = 0; i < n; ++i) {
+    const auto r = urd(mt), y = urd(mt), dr = urd(mt), dy = urd(mt);
+    const auto describe = [&] {
+      std::stringstream ss;
+      ss << "r: " << r << " y: " << y << " dr: " << dr << " dy: " << dy;
+      return ss.str();
+    };
+    p.measure(
+        "-", [&] { sink = fc.update(r, y, dr, dy, 1e-3f); }, describe);
+    p_fast.measure(
+        "-", [&] { sink = fc.updateFast(r, y, dr, dy, 1e-3f); }, describe);
+  }
+  p.report(std::cout), p.writeCsv(csv);
+  p_fast.report(std::cout), p_fast.writeCsv(csv);
+}
+
+int main(void) {
+  /* fixed seed to reproduce the worst case */
+  std::mt19937 mt{1};
+  std::ofstream csv("wcet.csv");
+  csv << "function,branch," << counter_unit << ",count" << std::endl;
+  Profiler::calibrate();
+
+  profileAccelDesigner(csv, makeConstraints(mt, 100000), mt);
+  profileAccelReplanner(csv, mt, 100000);
+  profileShape(csv, mt, 10000);
+  profileTrajectoryTracker(csv, mt, 100000);
+  profileFeedbackController(csv, mt, 100000);
+
+  return 0;
+}
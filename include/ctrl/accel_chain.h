@@ -0,0 +1,156 @@
+/**
+ * @file accel_chain.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 連結した曲線加減速の区間の接続速度を一括で求めるクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_designer.h"
+
+#include <algorithm> //< for std::min, std::upper_bound
+#include <cstddef>   //< for std::size_t
+#include <vector>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 連結した曲線加減速の軌道
+ *
+ * - 各区間の距離と各接続点の速度の上限から，後ろ向きと前向きの2回の走査で
+ *   実現可能な接続速度を O(n) で求める (planVelocities())
+ *   - 後ろ向き: 次の接続点の速度まで減速しきれる速度に制限する
+ *   - 前向き: 前の接続点の速度から加速しきれる速度に制限する
+ * - 求めた接続速度で各区間の AccelDesigner を1回ずつ生成する
+ * - 移動方向は正，速度は非負とする
+ */
+class AccelChain {
+public:
+  /**
+   * @brief 空のコンストラクタ．あとで reset() により初期化すること．
+   */
+  AccelChain() {}
+  /**
+   * @brief 区間の列から軌道を生成する関数
+   *
+   * @param j_max 最大躍度の大きさ [m/s/s/s]
+   * @param a_max 最大加速度の大きさ [m/s/s]
+   * @param v_max 最大速度の大きさ [m/s]
+   * @param distances 各区間の距離 [m] (n 個)
+   * @param v_limits 各接続点の速度の上限 [m/s] (n + 1 個)．
+   * 先頭は始点速度，末尾は終点速度とする．
+   * @param x_start 始点位置 [m] (オプション)
+   * @param t_start 始点時刻 [s] (オプション)
+   */
+  void reset(const float j_max, const float a_max, const float v_max,
+             const std::vector<float> &distances,
+             const std::vector<float> &v_limits, const float x_start = 0,
+             const float t_start = 0) {
+    const auto n = distances.size();
+    vs.resize(n + 1);
+    for (std::size_t i = 0; i <= n; ++i)
+      vs[i] = i < v_limits.size() ? std::min(v_limits[i], v_max) : 0;
+    vs[0] = v_limits.empty() ? 0 : v_limits[0]; //< 始点速度は変えない
+    planVelocities(j_max, a_max, distances.data(), vs.data(), n);
+    ts.resize(n);
+    segments.resize(n);
+    float x = x_start, t = t_start;
+    for (std::size_t i = 0; i < n; ++i) {
+      auto &ad = segments[i];
+      ad.reset(j_max, a_max, v_max, i ? segments[i - 1].v_end() : vs[0],
+               vs[i + 1], distances[i], x, t);
+      ts[i] = t;
+      x = ad.x_end(), t = ad.t_end();
+    }
+  }
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const { return at(t).j(t); }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const { return at(t).a(t); }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const { return at(t).v(t); }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const { return at(t).x(t); }
+  /**
+   * @brief 時刻 t [s] の属する区間．区間が空でないこと．
+   */
+  const AccelDesigner &at(const float t) const {
+    const auto it = std::upper_bound(ts.begin(), ts.end(), t);
+    return segments[it == ts.begin() ? 0 : it - ts.begin() - 1];
+  }
+  /**
+   * @brief 終点時刻 [s]
+   */
+  float t_end() const { return segments.empty() ? 0 : segments.back().t_end(); }
+  /**
+   * @brief 区間の配列を取得
+   */
+  const std::vector<AccelDesigner> &getSegments() const { return segments; }
+  /**
+   * @brief 計画した接続速度の配列を取得
+   */
+  const std::vector<float> &getVelocities() const { return vs; }
+
+public:
+  /**
+   * @brief 接続速度を前後2回の走査で求める関数
+   *
+   * v[0] は始点速度として変更しない．始点速度が速すぎて v[1] まで
+   * 減速しきれない場合は，その区間の終点速度が v[1] を超える．
+   *
+   * @param j_max 最大躍度の大きさ [m/s/s/s]
+   * @param a_max 最大加速度の大きさ [m/s/s]
+   * @param d 各区間の距離 [m] (n 個)
+   * @param v 各接続点の速度の上限 [m/s] (n + 1 個)．結果で上書きされる．
+   * @param n 区間の数
+   */
+  static void planVelocities(const float j_max, const float a_max,
+                             const float *d, float *v, const std::size_t n) {
+    /* 後ろ向き: 減速は逆向きの加速と同じ距離となる．
+     * 丸め誤差で AccelDesigner が減速しきれないと判定しないよう，
+     * 距離にわずかな余裕を持たせる */
+    const float margin = 1 - 1e-4f;
+    for (std::size_t i = n; i-- > 1;)
+      v[i] = std::min(v[i],
+                      reachable(j_max, a_max, v[i + 1], v[i], d[i] * margin));
+    /* 前向き */
+    for (std::size_t i = 0; i < n; ++i)
+      v[i + 1] =
+          std::min(v[i + 1], reachable(j_max, a_max, v[i], v[i + 1], d[i]));
+  }
+  /**
+   * @brief 距離 d [m] で始点速度 vs から加速して到達できる速度
+   *
+   * 目標速度 vt が vs 以下なら制限はなく vt を返す．
+   */
+  static float reachable(const float j_max, const float a_max, const float vs,
+                         const float vt, const float d) {
+    if (vt <= vs)
+      return vt;
+    if (d <= 0)
+      return vs;
+    const auto d_min =
+        AccelCurve::calcDistanceFromVelocityStartToEnd(j_max, a_max, vs, vt);
+    if (d_min <= d)
+      return vt;
+    return AccelCurve::calcReachableVelocityEnd(j_max, a_max, vs, vt, d);
+  }
+
+protected:
+  std::vector<float> ts;               /**< @brief 各区間の始点時刻 [s] */
+  std::vector<AccelDesigner> segments; /**< @brief 区間 */
+  std::vector<float> vs;               /**< @brief 接続速度 [m/s] */
+};
+
+} // namespace ctrl
@@ -7,6 +7,9 @@
  */
 #pragma once
 
+#include "csv_writer.h"
+#include "piecewise_polynomial.h"
+
 #include <array>
 #include <cmath>    //< for std::sqrt, std::cbrt
 #include <iostream> //< for std::cout
@@ -47,6 +50,17 @@
 #define ctrl_logd std::ostream(0)
 #endif
 
+/* evaluation mode definition */
+/**
+ * @brief 1 にすると，軌道の評価関数 j(t), a(t), v(t), x(t) を分岐なしの
+ * 定数時間で計算する．
+ * 時刻に依らず実行時間が一定になるので，制御周期の割り込みで使用する場合に有用．
+ * ただし，係数表を保持するため AccelCurve のサイズが大きくなる．
+ */
+#ifndef CTRL_ACCEL_CONSTANT_TIME
+#define CTRL_ACCEL_CONSTANT_TIME 0
+#endif
+
 /**
  * @brief 制御関係の名前空間
  */
@@ -79,6 +93,9 @@ public:
    */
   AccelCurve() {
     jm = am = t0 = t1 = t2 = t3 = v0 = v1 = v2 = v3 = x0 = x1 = x2 = x3 = 0;
+#if CTRL_ACCEL_CONSTANT_TIME
+    updateSegments();
+#endif
   }
   /**
    * @brief 引数の拘束条件から曲線を生成する．
@@ -112,18 +129,39 @@ public:
       v1 = v0 + am * tc / 2;                //< v(t) を積分
       v2 = v1 + am * tm;                    //< v(t) を積分
       x1 = x0 + v0 * tc + am * tc * tc / 6; //< x(t) を積分
-      x2 = x1 + v1 * tm;                    //< x(t) を積分
-      x3 = x0 + (v0 + v3) / 2 * (t3 - t0); //< v(t) グラフの台形の面積より
+      x2 = x1 + v1 * tm + am * tm * tm / 2; //< x(t) を積分
+      x3 = x0 + (v0 + v3) / 2 * (t3 - t0);  //< v(t) グラフの台形の面積より
     } else {
       /* 速度: 曲線 -> 曲線 */
       const auto tcp = std::sqrt((v3 - v0) / jm); //< 変曲までの時間
       t1 = t2 = t0 + tcp;
       t3 = t2 + tcp;
       v1 = v2 = (v0 + v3) / 2; //< 対称性より中点となる
-      x1 = x2 = x0 + v1 * tcp + jm * tcp * tcp * tcp / 6; //< x(t) を積分
+      x1 = x2 = x0 + v0 * tcp + jm * tcp * tcp * tcp / 6; //< x(t) を積分
       x3 = x0 + 2 * v1 * tcp; //< 速度 v(t) グラフの面積より
     }
+#if CTRL_ACCEL_CONSTANT_TIME
+    updateSegments();
+#endif
   }
+#if CTRL_ACCEL_CONSTANT_TIME
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const { return pp.j(t); }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const { return pp.a(t); }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const { return pp.v(t); }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const { return pp.x(t); }
+#else
   /**
    * @brief 時刻 t [s] における躍度 j [m/s/s/s]
    */
@@ -184,6 +222,34 @@ public:
     else
       return x3 + v3 * (t - t3);
   }
+#endif
+  /**
+   * @brief 位置 x [m] に到達する時刻 t [s]
+   *
+   * - 速度の符号が変化しない (位置が単調に変化する) 曲線であること
+   * - 等速区間は1次方程式，等加速度区間は2次方程式を解析的に解く
+   * - 躍度一定区間は3次方程式を解析的に解き，Newton 法で丸め誤差を修正する
+   * - 曲線の範囲外の位置は，始点速度または終点速度で外挿した時刻を返す
+   */
+  float t(const float x) const {
+    const float s = (x3 >= x0) ? 1 : -1; //< 進行方向
+    if (s * (x - x0) <= 0) {
+      /* 始点以前: 等速 */
+      return v0 != 0 ? t0 + (x - x0) / v0 : t0;
+    } else if (s * (x - x1) <= 0) {
+      /* 躍度一定: x - x0 = v0 tau + jm / 6 tau^3 (tau = t - t0) */
+      return t0 + solveCubic(v0, jm / 6, x - x0, t1 - t0);
+    } else if (s * (x - x2) <= 0) {
+      /* 加速度一定: x - x1 = v1 tau + am / 2 tau^2 (tau = t - t1) */
+      return t1 + clamp(solveQuadratic(v1, am, x - x1), 0, t2 - t1);
+    } else if (s * (x - x3) <= 0) {
+      /* 躍度一定: x3 - x = v3 tau - jm / 6 tau^3 (tau = t3 - t) */
+      return t3 - solveCubic(v3, -jm / 6, x3 - x, t3 - t2);
+    } else {
+      /* 終点以降: 等速 */
+      return v3 != 0 ? t3 + (x - x3) / v3 : t3;
+    }
+  }
   /**
    * @brief 終点時刻 [s]
    */
@@ -196,6 +262,18 @@ public:
    * @brief 終点位置 [m]
    */
   float x_end() const { return x3; }
+  /**
+   * @brief 始点速度 [m/s]
+   */
+  float v_start() const { return v0; }
+  /**
+   * @brief 最大躍度の大きさ [m/s/s/s]
+   */
+  float j_max() const { return std::abs(jm); }
+  /**
+   * @brief 最大加速度の大きさ [m/s/s]
+   */
+  float a_max() const { return std::abs(am); }
   /**
    * @brief 境界の時刻 [s]
    */
@@ -209,12 +287,19 @@ public:
   const std::array<float, 4> getTimeStamp() const { return {{t0, t1, t2, t3}}; }
   /**
    * @brief std::ostream に軌道のcsvを出力する関数．
+   * 組込み環境でも使えるよう，バッファは 1 KiB とする．
    */
   void printCsv(std::ostream &os, const float t_interval = 1e-3f) const {
-    for (float t = t0; t < t_end(); t += t_interval) {
-      os << t << "," << j(t) << "," << a(t) << "," << v(t) << "," << x(t)
-         << std::endl;
-    }
+    CsvWriter csv(os, 1 << 10);
+    printCsv(csv, t_interval);
+  }
+  /**
+   * @brief 呼び出し側の CsvWriter に軌道のcsvを出力する関数．
+   * 繰り返し出力する場合はバッファを使い回せる．
+   */
+  void printCsv(CsvWriter &csv, const float t_interval = 1e-3f) const {
+    for (float t = t0; t < t_end(); t += t_interval)
+      csv.row({t, j(t), a(t), v(t), x(t)});
   }
   /**
    * @brief 情報の表示
@@ -342,6 +427,63 @@ public:
         (tm > 0) ? (tc + tm + tc) : (2 * std::sqrt((v_end - v_start) / jm));
     return (v_start + v_end) / 2 * t_all; //< 速度グラフの面積により
   }
+  /**
+   * @brief 等加速度運動 $dx = v \\tau + a \\tau^2 / 2$ を解く関数
+   *
+   * 桁落ちを避けるため，解の公式を有理化した形で計算する．
+   *
+   * @param v  初速度 [m/s]
+   * @param a  加速度 [m/s/s]
+   * @param dx 変位 [m]
+   * @return tau 変位 dx に到達する最初の時間 [s]
+   */
+  static float solveQuadratic(const float v, const float a, const float dx) {
+    const auto D = v * v + 2 * a * dx;
+    const auto sqrtD = std::sqrt(D > 0 ? D : 0);
+    const auto den = v + (dx > 0 ? sqrtD : -sqrtD);
+    return den != 0 ? 2 * dx / den : 0;
+  }
+  /**
+   * @brief 躍度一定の運動 $dx = v \\tau + k \\tau^3$ を解く関数
+   *
+   * - 速度が増加する場合は，実数解が1つなので Cardano の公式で解く
+   * - 速度が減少する場合は，3つの実数解のうち最小の正の解を三角関数で解く
+   * - いずれも得られた解に Newton 法を1回適用して丸め誤差を修正する
+   * - 速度と変位は同じ向き (v dx >= 0) であること
+   *
+   * @param v  初速度 [m/s]
+   * @param k  3次の係数 (躍度の 1/6) [m/s/s/s]
+   * @param dx 変位 [m]
+   * @param T  区間の長さ [s]
+   * @return tau 変位 dx に到達する時間 [s], 0 <= tau <= T
+   */
+  static float solveCubic(const float v, const float k, const float dx,
+                          const float T) {
+    float tau;
+    if (k * dx > 0) {
+      /* 実数解は1つ: tau^3 + p tau + q = 0, p >= 0, q < 0 */
+      const auto p = v / k;
+      const auto q = -dx / k;
+      const auto sqrtD = std::sqrt(q * q / 4 + p * p * p / 27);
+      const auto w = std::cbrt(-q / 2 + sqrtD);
+      const auto z = p / 3 / w;
+      tau = -q / (w * w + w * z + z * z); //< = w - z, 桁落ちを回避
+    } else if (k * dx < 0 && v != 0) {
+      /* 実数解は3つ: tau^3 + p tau + q = 0, p < 0, q > 0 */
+      const auto p = v / k;
+      const auto q = -dx / k;
+      const auto m = std::sqrt(-p / 3); //< 極小点 (中央の解は 0 < tau < m)
+      const auto th = std::acos(clamp(3 * q / (2 * p * m), -1, 1));
+      tau = 2 * m * std::cos((th - float(2 * M_PI)) / 3);
+    } else {
+      tau = v != 0 ? dx / v : 0; //< k == 0 or dx == 0
+    }
+    tau = clamp(tau, 0, T);
+    /* Newton 法 */
+    const auto f = v * tau + k * tau * tau * tau - dx;
+    const auto df = v + 3 * k * tau * tau;
+    return df != 0 ? clamp(tau - f / df, 0, T) : tau;
+  }
 
 protected:
   float jm;             /**< @brief 躍度定数 [m/s/s/s] */
@@ -349,5 +491,29 @@ protected:
   float t0, t1, t2, t3; /**< @brief 時刻定数 [s] */
   float v0, v1, v2, v3; /**< @brief 速度定数 [m/s] */
   float x0, x1, x2, x3; /**< @brief 位置定数 [m] */
+
+  /**
+   * @brief 値を範囲 [lo, hi] に制限する関数
+   */
+  static float clamp(const float x, const float lo, const float hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+  }
+#if CTRL_ACCEL_CONSTANT_TIME
+  PiecewisePolynomial<4> pp; /**< @brief 区間の係数表 */
+
+  /**
+   * @brief 境界値から区間の係数表を生成する
+   */
+  void updateSegments() {
+    const std::array<PiecewisePolynomial<4>::Segment, 5> seg = {{
+        {t0, {{x0, v0, 0, 0}}},       //< 始点以前: 等速
+        {t0, {{x0, v0, 0, jm / 6}}},  //< 躍度一定
+        {t1, {{x1, v1, am / 2, 0}}},  //< 加速度一定
+        {t3, {{x3, v3, 0, -jm / 6}}}, //< 躍度一定
+        {t3, {{x3, v3, 0, 0}}},       //< 終点以降: 等速
+    }};
+    pp = PiecewisePolynomial<4>({{t0, t1, t2, t3}}, seg);
+  }
+#endif
 };
 } // namespace ctrl
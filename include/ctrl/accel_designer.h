@@ -97,19 +97,11 @@ public:
       ac.reset(j_max, a_max, v_start, v_sat); //< 加速
       dc.reset(j_max, a_max, v_sat, v_end);   //< 減速
     }
-    /* t23 = nan 回避; vs = ve = d = 0 のときに発生 */
-    if (v_sat == 0)
-      v_sat = 1;
     /* 各定数の算出 */
-    const auto t23 = (dist - ac.x_end() - dc.x_end()) / v_sat;
-    x0 = x_start;
-    x3 = x_start + dist;
-    t0 = t_start;
-    t1 = t0 + ac.t_end();                    //< 曲線加速終了の時刻
-    t2 = t0 + ac.t_end() + t23;              //< 等速走行終了の時刻
-    t3 = t0 + ac.t_end() + t23 + dc.t_end(); //< 曲線減速終了の時刻
+    updateBoundary(v_sat, dist, x_start, t_start);
 #if 0
     /* 出力のチェック */
+    const auto t23 = t2 - t1;
     const auto e = 0.01f; //< 数値誤差分
     bool show_info = false;
     /* 飽和速度時間 */
@@ -155,6 +147,37 @@ public:
     }
 #endif
   }
+#if CTRL_ACCEL_CONSTANT_TIME
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const {
+    const int i = t >= t2;
+    return curve(i).j(t - t_offset(i));
+  }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const {
+    const int i = t >= t2;
+    return curve(i).a(t - t_offset(i));
+  }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const {
+    const int i = t >= t2;
+    return curve(i).v(t - t_offset(i));
+  }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const {
+    const int i = t >= t2;
+    const float x_offset[2] = {x0, x3 - dc.x_end()};
+    return x_offset[i] + curve(i).x(t - t_offset(i));
+  }
+#else
   /**
    * @brief 時刻 t [s] における躍度 j [m/s/s/s]
    */
@@ -191,6 +214,26 @@ public:
     else
       return x3 - dc.x_end() + dc.x(t - t2);
   }
+#endif
+  /**
+   * @brief 位置 x [m] に到達する時刻 t [s]
+   *
+   * - 曲線加速・等速・曲線減速の区間を位置により判定して解析的に求める
+   * - 速度の符号が変化しない軌道であること
+   * - 範囲外の位置は，始点速度または終点速度で外挿した時刻を返す
+   */
+  float t(const float x) const {
+    const float s = (x3 >= x0) ? 1 : -1; //< 進行方向
+    const auto x1 = x0 + ac.x_end();     //< 曲線加速終了の位置
+    const auto x2 = x3 - dc.x_end();     //< 等速走行終了の位置
+    if (s * (x - x1) < 0)
+      return t0 + ac.t(x - x0);
+    if (s * (x - x2) < 0) {
+      const auto v_sat = ac.v_end();
+      return v_sat != 0 ? t1 + (x - x1) / v_sat : t1;
+    }
+    return t2 + dc.t(x - x2);
+  }
   /**
    * @brief 終点時刻 [s]
    */
@@ -218,11 +261,19 @@ public:
   }
   /**
    * @brief std::ostream に軌道のcsvを出力する関数．
+   * 組込み環境でも使えるよう，バッファは 1 KiB とする．
    */
   void printCsv(std::ostream &os, const float t_interval = 1e-3f) const {
+    CsvWriter csv(os, 1 << 10);
+    printCsv(csv, t_interval);
+  }
+  /**
+   * @brief 呼び出し側の CsvWriter に軌道のcsvを出力する関数．
+   * 繰り返し出力する場合はバッファを使い回せる．
+   */
+  void printCsv(CsvWriter &csv, const float t_interval = 1e-3f) const {
     for (float t = t0; t < t_end(); t += t_interval)
-      os << t << "," << j(t) << "," << a(t) << "," << v(t) << "," << x(t)
-         << std::endl;
+      csv.row({t, j(t), a(t), v(t), x(t)});
   }
   /**
    * @brief 情報の表示
@@ -255,11 +306,87 @@ public:
     }};
   }
 
+  /**
+   * @brief 軌道を決める最小限の値 (32 byte)
+   *
+   * - reset() で拘束条件を解いた結果の飽和速度を含むので，unpack() は
+   *   方程式を解かずに2つの AccelCurve を生成するのみとなる
+   * - 多数の区間からなる走行計画を少ないメモリで保持するために用いる
+   *   (AccelSequence)
+   */
+  struct Packed {
+    float j_max;   /**< @brief 最大躍度の大きさ [m/s/s/s] */
+    float a_max;   /**< @brief 最大加速度の大きさ [m/s/s] */
+    float v_start; /**< @brief 始点速度 [m/s] */
+    float v_sat;   /**< @brief 飽和速度 [m/s] */
+    float v_end;   /**< @brief 終点速度 [m/s] */
+    float dist;    /**< @brief 移動距離 [m] */
+    float x_start; /**< @brief 始点位置 [m] */
+    float t_start; /**< @brief 始点時刻 [s] */
+  };
+  /**
+   * @brief 軌道を Packed に詰める関数
+   */
+  Packed pack() const {
+    Packed p;
+    p.j_max = ac.j_max(), p.a_max = ac.a_max();
+    p.v_start = ac.v_start(), p.v_sat = ac.v_end(), p.v_end = dc.v_end();
+    p.dist = x3 - x0, p.x_start = x0, p.t_start = t0;
+    return p;
+  }
+  /**
+   * @brief Packed から軌道を復元する関数．
+   * 丸め誤差を除いて reset() の結果と一致する．
+   */
+  void unpack(const Packed &p) {
+    if (p.j_max == 0) {
+      *this = AccelDesigner(); //< 空の軌道
+      return;
+    }
+    ac.reset(p.j_max, p.a_max, p.v_start, p.v_sat);
+    dc.reset(p.j_max, p.a_max, p.v_sat, p.v_end);
+    updateBoundary(p.v_sat, p.dist, p.x_start, p.t_start);
+  }
+
 protected:
   float t0, t1, t2, t3; /**< @brief 境界点の時刻 [s] */
   float x0, x3;         /**< @brief 境界点の位置 [m] */
   AccelCurve ac;        /**< @brief 曲線加速用オブジェクト */
   AccelCurve dc;        /**< @brief 曲線減速用オブジェクト */
+
+  /**
+   * @brief 生成済みの ac, dc から境界点の時刻と位置を算出する
+   */
+  void updateBoundary(float v_sat, const float dist, const float x_start,
+                      const float t_start) {
+    /* t23 = nan 回避; vs = ve = d = 0 のときに発生 */
+    if (v_sat == 0)
+      v_sat = 1;
+    const auto t23 = (dist - ac.x_end() - dc.x_end()) / v_sat;
+    x0 = x_start;
+    x3 = x_start + dist;
+    t0 = t_start;
+    t1 = t0 + ac.t_end();                    //< 曲線加速終了の時刻
+    t2 = t0 + ac.t_end() + t23;              //< 等速走行終了の時刻
+    t3 = t0 + ac.t_end() + t23 + dc.t_end(); //< 曲線減速終了の時刻
+  }
+
+#if CTRL_ACCEL_CONSTANT_TIME
+  /**
+   * @brief 区間番号 (0: 加速, 1: 減速) の曲線を分岐なしで選択する
+   */
+  const AccelCurve &curve(const int i) const {
+    const AccelCurve *const c[2] = {&ac, &dc};
+    return *c[i];
+  }
+  /**
+   * @brief 区間番号 (0: 加速, 1: 減速) の曲線の基準時刻 [s]
+   */
+  float t_offset(const int i) const {
+    const float t[2] = {t0, t2};
+    return t[i];
+  }
+#endif
 };
 
 } // namespace ctrl
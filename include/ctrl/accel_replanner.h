@@ -0,0 +1,168 @@
+/**
+ * @file accel_replanner.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 加速度が0でない途中の状態から曲線加減速を設計し直すクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_designer.h"
+
+#include <cmath>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 走行中の状態 (v, a) から続く曲線加減速の軌道
+ *
+ * AccelDesigner は始点と終点の加速度を0とするので，加速中に目標を
+ * 変えると加速度が不連続になる．このクラスは次のいずれかで躍度の制限を
+ * 守ったまま軌道をつなぐ．
+ *
+ * 1. 仮想始点: 加速度0から最大躍度で現在の加速度に達するまでの時間
+ *    $t_r = |a|/j_{\max}$ だけ遡った点を始点とした AccelDesigner が
+ *    現在の (v, a) を通るならば，その続きをそのまま用いる．
+ *    目標速度が現在の加速の向きにあり，十分に離れている場合に該当する．
+ * 2. 上記が成り立たない場合は，最大躍度で加速度を0に戻す区間を置き，
+ *    その終点から AccelDesigner を設計する．
+ *
+ * どちらも AccelDesigner::reset() を高々2回呼ぶのみで，反復がないので
+ * 最悪実行時間が有界となる (examples/wcet で計測)．
+ *
+ * @code {.cpp}
+ * ctrl::AccelReplanner ar;
+ * ar.replan(j_max, a_max, v_max, ad, t, v_target, dist); // ad を走行中
+ * @endcode
+ */
+class AccelReplanner {
+public:
+  /**
+   * @brief 空のコンストラクタ．あとで reset() により初期化すること．
+   */
+  AccelReplanner() { t0 = tp = x0 = v0 = a0 = jp = 0; }
+  /**
+   * @brief 現在の状態から軌道を設計する関数
+   *
+   * 加速度を0に戻す区間で移動距離を使い切る場合は，目標速度まで
+   * 変化しきるのに必要な距離に延長する (終点位置を行き過ぎる)．
+   *
+   * @param j_max     最大躍度の大きさ [m/s/s/s]，正であること
+   * @param a_max     最大加速度の大きさ [m/s/s], 正であること
+   * @param v_max     最大速度の大きさ [m/s]，正であること
+   * @param v_start   現在の速度 [m/s]
+   * @param a_start   現在の加速度 [m/s/s]
+   * @param v_target  目標速度 [m/s]
+   * @param dist      現在位置からの移動距離 [m]
+   * @param x_start   現在位置 [m] (オプション)
+   * @param t_start   現在時刻 [s] (オプション)
+   */
+  void reset(const float j_max, const float a_max, const float v_max,
+             const float v_start, const float a_start, const float v_target,
+             const float dist, const float x_start = 0,
+             const float t_start = 0) {
+    t0 = tp = t_start;
+    x0 = x_start, v0 = v_start, a0 = a_start;
+    const float tr = std::abs(a_start) / j_max; //< 加速度0からの時間
+    /* 1. 仮想始点から設計し，現在の状態を通るか確認 */
+    if (std::abs(a_start) <= a_max) {
+      const float jr = a_start > 0 ? j_max : -j_max;
+      const float vr = v_start - a_start * tr / 2; //< 仮想始点の速度
+      const float xr = vr * tr + jr * tr * tr * tr / 6;
+      ad.reset(j_max, a_max, v_max, vr, v_target, dist + xr, x_start - xr,
+               t_start - tr);
+      const float v_tol = 1e-4f * (std::abs(v_start) + a_max * a_max / j_max);
+      if (std::abs(ad.a(t_start) - a_start) <= 1e-3f * a_max &&
+          std::abs(ad.v(t_start) - v_start) <= v_tol)
+        return;
+    }
+    /* 2. 加速度を0に戻してから設計 */
+    jp = a_start > 0 ? -j_max : j_max;
+    tp = t_start + tr;
+    const float vp = v_start + a_start * tr / 2;
+    const float xp = a_start * tr * tr / 3 + v_start * tr;
+    auto d = dist - xp;
+    if (d * dist <= 0)
+      d = AccelCurve::calcDistanceFromVelocityStartToEnd(j_max, a_max, vp,
+                                                         v_target);
+    ad.reset(j_max, a_max, v_max, vp, v_target, d, x_start + xp, tp);
+  }
+  /**
+   * @brief 走行中の軌道の時刻 t [s] の状態から設計し直す関数
+   *
+   * @param running 走行中の軌道 (AccelDesigner, AccelReplanner など)
+   * @param t 現在時刻 [s]
+   * @param v_target 目標速度 [m/s]
+   * @param dist 現在位置からの移動距離 [m]
+   */
+  template <typename A>
+  void replan(const float j_max, const float a_max, const float v_max,
+              const A &running, const float t, const float v_target,
+              const float dist) {
+    reset(j_max, a_max, v_max, running.v(t), running.a(t), v_target, dist,
+          running.x(t), t);
+  }
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const { return t < tp ? jp : ad.j(t); }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const {
+    if (t >= tp)
+      return ad.a(t);
+    const float tau = t - t0;
+    return a0 + jp * tau;
+  }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const {
+    if (t >= tp)
+      return ad.v(t);
+    const float tau = t - t0;
+    return v0 + (a0 + jp * tau / 2) * tau;
+  }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const {
+    if (t >= tp)
+      return ad.x(t);
+    const float tau = t - t0;
+    return x0 + (v0 + (a0 / 2 + jp * tau / 6) * tau) * tau;
+  }
+  /**
+   * @brief 終点時刻 [s]
+   */
+  float t_end() const { return ad.t_end(); }
+  /**
+   * @brief 終点速度 [m/s]
+   */
+  float v_end() const { return ad.v_end(); }
+  /**
+   * @brief 終点位置 [m]
+   */
+  float x_end() const { return ad.x_end(); }
+  /**
+   * @brief 加速度を0に戻す区間があるか
+   */
+  bool hasRamp() const { return tp > t0; }
+  /**
+   * @brief 続きの AccelDesigner を取得．
+   * 加速度を0に戻す区間がない場合，その始点時刻は現在時刻より前となる．
+   */
+  const AccelDesigner &getAccelDesigner() const { return ad; }
+
+protected:
+  float t0;         /**< @brief 現在時刻 [s] */
+  float tp;         /**< @brief 加速度を0に戻す区間の終点時刻 [s] */
+  float x0, v0, a0; /**< @brief 現在の位置，速度，加速度 */
+  float jp;         /**< @brief 加速度を0に戻す区間の躍度 [m/s/s/s] */
+  AccelDesigner ad; /**< @brief 続きの曲線加減速 */
+};
+
+} // namespace ctrl
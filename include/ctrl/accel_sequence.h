@@ -0,0 +1,120 @@
+/**
+ * @file accel_sequence.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 曲線加減速の区間の列を詰めて保持するコンテナを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_designer.h"
+
+#include <array>
+#include <cstddef> //< for std::size_t
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 曲線加減速の区間の列
+ *
+ * - 各区間を AccelDesigner::Packed (32 byte) で保持する．
+ *   AccelDesigner をそのまま並べる場合の 1/4 程度の大きさとなる
+ * - 固定長の配列に保持するので動的確保を行わない
+ * - 時刻 t を含む区間を二分探索し，必要になったときに展開する．
+ *   直前に展開した区間を1つ保持するので，時刻順に評価する制御周期では
+ *   区間の切り替わり時のみ展開が発生する
+ * - 展開結果の保持のため，const な評価関数も並行して呼ばないこと
+ *
+ * @tparam N 区間の最大数
+ */
+template <std::size_t N> class AccelSequence {
+public:
+  AccelSequence() { clear(); }
+  /**
+   * @brief 区間を末尾に追加する関数．時刻順に追加すること．
+   *
+   * @return 追加できたか (満杯なら false)
+   */
+  bool push(const AccelDesigner &ad) {
+    if (count >= N)
+      return false;
+    data[count++] = ad.pack();
+    return true;
+  }
+  /**
+   * @brief 区間を空にする関数
+   */
+  void clear() {
+    count = 0;
+    cached = N;
+  }
+  /**
+   * @brief i 番目の区間を展開して返す関数
+   */
+  AccelDesigner operator[](const std::size_t i) const {
+    AccelDesigner ad;
+    ad.unpack(data[i]);
+    return ad;
+  }
+  /**
+   * @brief 時刻 t [s] を含む区間の番号．区間が空でないこと．
+   */
+  std::size_t index(const float t) const {
+    std::size_t lo = 0, hi = count; //< data[lo].t_start <= t の最大の lo
+    while (hi - lo > 1) {
+      const auto mid = (lo + hi) / 2;
+      if (data[mid].t_start <= t)
+        lo = mid;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+  /**
+   * @brief 時刻 t [s] を含む区間を展開して返す関数．区間が空でないこと．
+   */
+  const AccelDesigner &at(const float t) const {
+    const auto i = index(t);
+    if (i != cached)
+      cache.unpack(data[i]), cached = i;
+    return cache;
+  }
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const { return at(t).j(t); }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const { return at(t).a(t); }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const { return at(t).v(t); }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const { return at(t).x(t); }
+  /**
+   * @brief 区間の数
+   */
+  std::size_t size() const { return count; }
+  /**
+   * @brief 区間の最大数
+   */
+  std::size_t capacity() const { return N; }
+  /**
+   * @brief 詰めた区間の配列
+   */
+  const AccelDesigner::Packed *getData() const { return data.data(); }
+
+protected:
+  std::array<AccelDesigner::Packed, N> data; /**< @brief 詰めた区間 */
+  std::size_t count;                         /**< @brief 区間の数 */
+  mutable std::size_t cached;                /**< @brief 展開済みの番号 */
+  mutable AccelDesigner cache;               /**< @brief 展開済みの区間 */
+};
+
+} // namespace ctrl
@@ -6,17 +6,25 @@
  */
 #pragma once
 
-#include <new>
+#include <algorithm>
+#include <array>
+#include <cstddef> //< for std::size_t
 
 namespace ctrl {
 
 /**
  * @brief データの蓄積器
  *
+ * - バッファはメンバとして保持するので，静的領域にも配置できる
+ * - T がトリビアルにコピー可能ならば，このクラスもトリビアルにコピー可能
+ * - S が2のべき乗のとき，添字の剰余はビットマスクで計算される
+ *
  * @tparam T データの型
  * @tparam S 蓄積するデータの数
  */
 template <typename T, std::size_t S> class Accumulator {
+  static_assert(S > 0, "size must be positive");
+
 public:
   /**
    * @brief コンストラクタ
@@ -24,30 +32,40 @@ public:
    * @param value バッファ内の全データに代入する初期値
    */
   Accumulator(const T &value = T()) {
-    buffer = new T[S];
     head = 0;
     clear(value);
   }
-  /**
-   * @brief デストラクタ
-   */
-  ~Accumulator() { delete[] buffer; }
   /**
    * @brief バッファをクリアする関数
    *
    * @param value 代入する値
    */
-  void clear(const T &value = T()) {
-    for (int i = 0; i < S; i++)
-      buffer[i] = value;
-  }
+  void clear(const T &value = T()) { buffer.fill(value); }
   /**
    * @brief 最新のデータを追加する関数
    */
   void push(const T &value) {
-    head = (head + 1) % S;
+    head = wrap(head + 1);
     buffer[head] = value;
   }
+  /**
+   * @brief 複数のデータをまとめて追加する関数
+   *
+   * DMA などで受け取ったデータ列を，折り返し位置の前後で高々2回の
+   * 連続コピーにより追加する．S 個を超える場合は新しい S 個のみを保持する．
+   *
+   * @param data データ列の先頭．data[0] が最古，data[n - 1] が最新．
+   * @param n データの数
+   */
+  void push(const T *data, std::size_t n) {
+    if (n > S)
+      data += n - S, n = S;
+    const auto first = wrap(head + 1);
+    const auto n1 = n < S - first ? n : S - first;
+    std::copy(data, data + n1, buffer.begin() + first);
+    std::copy(data + n1, data + n, buffer.begin());
+    head = wrap(head + n);
+  }
   /**
    * @brief 直近 index 番目の値を取得するオペレータ
    *
@@ -57,7 +75,7 @@ public:
    * @return const T&
    */
   const T &operator[](const std::size_t index) const {
-    return buffer[((int)S + head - index) % S];
+    return buffer[pos(index)];
   }
   /**
    * @brief 直近 n 個の平均を取得する関数
@@ -68,7 +86,7 @@ public:
   const T average(const int n = S) const {
     T sum = T();
     for (int i = 0; i < n; i++) {
-      sum += buffer[((int)S + head - i) % S];
+      sum += buffer[pos(i)];
     }
     return sum / n;
   }
@@ -77,9 +95,425 @@ public:
    */
   std::size_t size() const { return S; }
 
-private:
-  T *buffer; /**< @brief リングバッファとして使う配列のポインタ */
-  std::size_t head; /**< @brief リングバッファの先頭インデックス */
+protected:
+  std::array<T, S> buffer; /**< @brief リングバッファとして使う配列 */
+  std::size_t head;        /**< @brief リングバッファの先頭インデックス */
+
+  /**
+   * @brief 添字を [0, S) に折り返す関数
+   */
+  static std::size_t wrap(const std::size_t i) {
+    return (S & (S - 1)) == 0 ? i & (S - 1) : i % S;
+  }
+  /**
+   * @brief 直近 index 番目のデータが格納されている配列の位置
+   */
+  std::size_t pos(const std::size_t index) const {
+    return wrap(S + head - index);
+  }
+};
+
+/**
+ * @brief 多段の間引きにより粗い時間分解能の履歴を保持する蓄積器
+ *
+ * - 段 0 に生データを蓄積し，段 i の R 個の平均を段 i + 1 に追加する
+ * - たとえば 1 kHz のデータを R = 10, L = 3 で蓄積すると，
+ *   1 kHz, 100 Hz, 10 Hz の履歴をそれぞれ S 個ずつ保持する
+ * - T は加算とスカラーによる除算を持つこと
+ *
+ * @tparam T データの型
+ * @tparam S 各段で蓄積するデータの数
+ * @tparam R 間引きの比率
+ * @tparam L 段の数
+ */
+template <typename T, std::size_t S, std::size_t R, std::size_t L>
+class DecimationCascade {
+  static_assert(R > 0 && L > 0, "invalid decimation");
+
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param value バッファ内の全データに代入する初期値
+   */
+  DecimationCascade(const T &value = T()) { clear(value); }
+  /**
+   * @brief バッファをクリアする関数
+   *
+   * @param value 代入する値
+   */
+  void clear(const T &value = T()) {
+    for (auto &l : levels)
+      l.clear(value);
+    sums.fill(T());
+    counts.fill(0);
+  }
+  /**
+   * @brief 最新の生データを追加する関数
+   */
+  void push(T value) {
+    for (std::size_t i = 0; i < L; ++i) {
+      levels[i].push(value);
+      if (i + 1 == L)
+        break;
+      sums[i] += value;
+      if (++counts[i] < R)
+        break;
+      /* R 個たまったら平均を次の段へ */
+      value = sums[i] / R;
+      sums[i] = T();
+      counts[i] = 0;
+    }
+  }
+  /**
+   * @brief 複数の生データをまとめて追加する関数
+   *
+   * @param data データ列の先頭．data[0] が最古，data[n - 1] が最新．
+   * @param n データの数
+   */
+  void push(const T *data, const std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i)
+      push(data[i]);
+  }
+  /**
+   * @brief 段 i の蓄積器を取得する関数
+   *
+   * @param i 段の番号．0 が生データで，段ごとに R 倍に間引かれる．
+   */
+  const Accumulator<T, S> &level(const std::size_t i) const {
+    return levels[i];
+  }
+
+protected:
+  std::array<Accumulator<T, S>, L> levels; /**< @brief 各段の蓄積器 */
+  std::array<T, L> sums;                   /**< @brief 各段の途中の和 */
+  std::array<std::size_t, L> counts;       /**< @brief 各段の途中の個数 */
+};
+
+/**
+ * @brief 統計量を逐次更新するデータの蓄積器
+ *
+ * - 累積和 (と2乗の累積和) をデータと同じリングバッファに保持し，
+ *   任意の個数の平均と分散を O(1) で計算する
+ * - 累積和の丸め誤差が蓄積しないよう，R 回の追加ごとに
+ *   生データから累積和を計算し直す (償却 O(S/R))
+ * - T は加減算，要素ごとの乗算，スカラーによる除算を持つこと
+ *
+ * @tparam T データの型
+ * @tparam S 蓄積するデータの数
+ * @tparam R 累積和を再計算する周期 [回]
+ */
+template <typename T, std::size_t S, std::size_t R = S>
+class RunningAccumulator : public Accumulator<T, S> {
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param value バッファ内の全データに代入する初期値
+   */
+  RunningAccumulator(const T &value = T()) : Accumulator<T, S>(value) {
+    resum();
+  }
+  /**
+   * @brief バッファをクリアする関数
+   *
+   * @param value 代入する値
+   */
+  void clear(const T &value = T()) {
+    Accumulator<T, S>::clear(value);
+    resum();
+  }
+  /**
+   * @brief 最新のデータを追加する関数
+   */
+  void push(const T &value) {
+    const T latest_sum = sum1[this->head];
+    const T latest_sq = sum2[this->head];
+    Accumulator<T, S>::push(value);
+    /* 上書きされる最古のデータまでの累積和を保持 */
+    tail1 = sum1[this->head];
+    tail2 = sum2[this->head];
+    sum1[this->head] = latest_sum + value;
+    sum2[this->head] = latest_sq + value * value;
+    if (++count >= R)
+      resum();
+  }
+  /**
+   * @brief 直近 n 個の和を取得する関数
+   *
+   * @param n 個数, 0 < n <= S
+   */
+  const T sum(const std::size_t n = S) const {
+    return sum1[this->head] - (n < S ? sum1[this->pos(n)] : tail1);
+  }
+  /**
+   * @brief 直近 n 個の平均を取得する関数
+   *
+   * @param n 平均個数, 0 < n <= S
+   * @return const T 平均値
+   */
+  const T average(const std::size_t n = S) const { return sum(n) / n; }
+  /**
+   * @brief 直近 n 個の分散 (標本分散ではなく母分散) を取得する関数
+   *
+   * 2乗の平均から平均の2乗を引いて求めるため，平均に比べて
+   * ばらつきが極端に小さい場合は桁落ちに注意すること．
+   *
+   * @param n 個数, 0 < n <= S
+   * @return const T 分散
+   */
+  const T variance(const std::size_t n = S) const {
+    const auto sq = sum2[this->head] - (n < S ? sum2[this->pos(n)] : tail2);
+    const auto mean = sum(n) / n;
+    return sq / n - mean * mean;
+  }
+  /**
+   * @brief 生データから累積和を計算し直す関数 O(S)
+   */
+  void resum() {
+    tail1 = tail2 = T();
+    T s1 = T(), s2 = T();
+    for (std::size_t i = S; i-- > 0;) {
+      const auto &value = (*this)[i];
+      s1 += value;
+      s2 += value * value;
+      sum1[this->pos(i)] = s1;
+      sum2[this->pos(i)] = s2;
+    }
+    count = 0;
+  }
+
+protected:
+  std::array<T, S> sum1; /**< @brief 累積和 */
+  std::array<T, S> sum2; /**< @brief 2乗の累積和 */
+  T tail1;               /**< @brief 最古のデータの直前までの累積和 */
+  T tail2;               /**< @brief 最古のデータの直前までの2乗の累積和 */
+  std::size_t count;     /**< @brief 前回の再計算からの追加回数 */
+};
+
+/**
+ * @brief 区間最小値・最大値を逐次更新するデータの蓄積器
+ *
+ * - 単調キュー (monotonic deque) により，バッファ全体の最小値と最大値を
+ *   償却 O(1) で更新する
+ * - キューはデータの追加番号を保持する固定長のリングバッファで，
+ *   追加の状態量は S に比例する
+ * - T は比較演算子 < を持つこと
+ *
+ * @tparam T データの型
+ * @tparam S 蓄積するデータの数
+ */
+template <typename T, std::size_t S>
+class MinMaxAccumulator : public Accumulator<T, S> {
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param value バッファ内の全データに代入する初期値
+   */
+  MinMaxAccumulator(const T &value = T()) : Accumulator<T, S>(value) {
+    count = 0;
+    rebuild();
+  }
+  /**
+   * @brief バッファをクリアする関数
+   *
+   * @param value 代入する値
+   */
+  void clear(const T &value = T()) {
+    Accumulator<T, S>::clear(value);
+    rebuild();
+  }
+  /**
+   * @brief 最新のデータを追加する関数
+   */
+  void push(const T &value) {
+    Accumulator<T, S>::push(value);
+    ++count;
+    /* 窓から外れた追加番号を先頭から取り除き，末尾に追加 */
+    lo.push(*this, count, [&](const T &back) { return value < back; });
+    hi.push(*this, count, [&](const T &back) { return back < value; });
+  }
+  /**
+   * @brief バッファ内の最小値
+   */
+  const T &min() const { return lo.front(*this, count); }
+  /**
+   * @brief バッファ内の最大値
+   */
+  const T &max() const { return hi.front(*this, count); }
+
+protected:
+  /**
+   * @brief 追加番号の単調キュー
+   */
+  struct Deque {
+    std::array<std::size_t, S> k; /**< @brief 追加番号のリングバッファ */
+    std::size_t first;            /**< @brief 先頭の位置 */
+    std::size_t size;             /**< @brief 要素数 */
+
+    /**
+     * @brief 追加番号 c のデータを追加する関数
+     *
+     * @param acc 蓄積器
+     * @param c 追加番号
+     * @param dominated 末尾のデータが不要になる条件
+     */
+    template <typename F>
+    void push(const MinMaxAccumulator &acc, const std::size_t c,
+              F dominated) {
+      if (size > 0 && c - k[first] >= S)
+        first = wrap(first + 1), --size;
+      while (size > 0 && dominated(acc[c - k[wrap(first + size - 1)]]))
+        --size;
+      k[wrap(first + size++)] = c;
+    }
+    /**
+     * @brief 先頭のデータを取得する関数
+     */
+    const T &front(const MinMaxAccumulator &acc, const std::size_t c) const {
+      return acc[c - k[first]];
+    }
+  };
+  Deque lo;          /**< @brief 最小値のキュー (昇順) */
+  Deque hi;          /**< @brief 最大値のキュー (降順) */
+  std::size_t count; /**< @brief 追加番号 (オーバーフローしても問題ない) */
+
+  /**
+   * @brief キューを初期化する関数
+   *
+   * クリア直後は全データが等しいので，最新のデータのみを保持する．
+   */
+  void rebuild() {
+    lo.k[0] = hi.k[0] = count;
+    lo.first = hi.first = 0;
+    lo.size = hi.size = 1;
+  }
+  using Accumulator<T, S>::wrap;
+};
+
+/**
+ * @brief 区間中央値を逐次更新するデータの蓄積器
+ *
+ * - バッファの位置を小さい半分の最大ヒープと大きい半分の最小ヒープに
+ *   分けて保持し，最古のデータを最新のデータで置き換えて O(log S) で更新する
+ * - ヒープは固定長の配列で，追加の状態量は S に比例する
+ * - S が偶数のときは，小さい方の中央値を返す
+ * - T は比較演算子 < を持つこと
+ *
+ * @tparam T データの型
+ * @tparam S 蓄積するデータの数
+ */
+template <typename T, std::size_t S>
+class MedianAccumulator : public Accumulator<T, S> {
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param value バッファ内の全データに代入する初期値
+   */
+  MedianAccumulator(const T &value = T()) : Accumulator<T, S>(value) {
+    rebuild();
+  }
+  /**
+   * @brief バッファをクリアする関数
+   *
+   * @param value 代入する値
+   */
+  void clear(const T &value = T()) {
+    Accumulator<T, S>::clear(value);
+    rebuild();
+  }
+  /**
+   * @brief 最新のデータを追加する関数
+   */
+  void push(const T &value) {
+    Accumulator<T, S>::push(value);
+    /* 置き換えた位置をヒープ内で移動 */
+    const auto i = where[this->head];
+    if (i < L) {
+      siftUp(0, i, true);
+      siftDown(0, L, where[this->head], true);
+    } else {
+      siftUp(L, i - L, false);
+      siftDown(L, S - L, where[this->head] - L, false);
+    }
+    /* 小さい半分の最大値 <= 大きい半分の最小値 を保つ */
+    if (L < S && at(L) < at(0)) {
+      swap(0, L);
+      siftDown(0, L, 0, true);
+      siftDown(L, S - L, 0, false);
+    }
+  }
+  /**
+   * @brief バッファ内の中央値
+   */
+  const T &median() const { return at(0); }
+
+protected:
+  static constexpr std::size_t L = (S + 1) / 2; /**< @brief 小さい半分の数 */
+  std::array<std::size_t, S> heap;  /**< @brief ヒープ (バッファの位置) */
+  std::array<std::size_t, S> where; /**< @brief 各位置のヒープ内位置 */
+
+  /**
+   * @brief ヒープ内位置 i のデータ
+   */
+  const T &at(const std::size_t i) const { return this->buffer[heap[i]]; }
+  /**
+   * @brief ヒープ内位置 a が b よりも根の側にあるべきか
+   *
+   * @param max 最大ヒープなら true, 最小ヒープなら false
+   */
+  bool before(const std::size_t a, const std::size_t b, const bool max) const {
+    return max ? at(b) < at(a) : at(a) < at(b);
+  }
+  /**
+   * @brief ヒープ内位置 a, b を入れ替える関数
+   */
+  void swap(const std::size_t a, const std::size_t b) {
+    std::swap(heap[a], heap[b]);
+    where[heap[a]] = a;
+    where[heap[b]] = b;
+  }
+  /**
+   * @brief ヒープ内位置 base + i の要素を根の側へ移動する関数
+   */
+  void siftUp(const std::size_t base, std::size_t i, const bool max) {
+    while (i > 0) {
+      const auto p = (i - 1) / 2;
+      if (!before(base + i, base + p, max))
+        break;
+      swap(base + i, base + p);
+      i = p;
+    }
+  }
+  /**
+   * @brief ヒープ内位置 base + i の要素を葉の側へ移動する関数
+   */
+  void siftDown(const std::size_t base, const std::size_t n, std::size_t i,
+                const bool max) {
+    for (auto c = 2 * i + 1; c < n; i = c, c = 2 * i + 1) {
+      if (c + 1 < n && before(base + c + 1, base + c, max))
+        ++c;
+      if (!before(base + c, base + i, max))
+        break;
+      swap(base + i, base + c);
+    }
+  }
+  /**
+   * @brief ヒープを整列により構築する関数 O(S log S)
+   */
+  void rebuild() {
+    for (std::size_t i = 0; i < S; ++i)
+      heap[i] = i;
+    std::sort(heap.begin(), heap.end(), [this](std::size_t a, std::size_t b) {
+      return this->buffer[a] < this->buffer[b];
+    });
+    /* 降順の配列は最大ヒープ，昇順の配列は最小ヒープ */
+    std::reverse(heap.begin(), heap.begin() + L);
+    for (std::size_t i = 0; i < S; ++i)
+      where[heap[i]] = i;
+  }
 };
 
 } // namespace ctrl
@@ -0,0 +1,282 @@
+/**
+ * @file binary_log.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 軌道や制御の記録を保存するバイナリ形式の読み書きを定義
+ * @date 2026-10-16
+ *
+ * ファイルの構成 (リトルエンディアン)
+ * - BinaryLogHeader (64 byte)
+ * - 列名 (列ごとに name_size byte, NUL 埋め)
+ * - data_offset 以降: float32 の行列 (rows 行 columns 列，行優先)
+ *
+ * 行優先で並べるので追記しながら書き出せる．各列は numpy の memmap で
+ * ストライド付きのビューとして複製せずに得られる (examples/ctrl_log.py)．
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CTRL_BINARY_LOG_MMAP 1
+#else
+#define CTRL_BINARY_LOG_MMAP 0
+#endif
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief バイナリ記録のヘッダ
+ */
+struct BinaryLogHeader {
+  char magic[8];        /**< @brief 識別子 "CTRLLOG" */
+  uint32_t version;     /**< @brief 形式のバージョン */
+  uint32_t columns;     /**< @brief 列の数 */
+  uint64_t rows;        /**< @brief 行の数．0 ならファイルサイズから求める */
+  uint32_t data_offset; /**< @brief データ先頭のファイル先頭からの位置 */
+  uint32_t name_size;   /**< @brief 列名1つあたりの大きさ [byte] */
+  char reserved[32];    /**< @brief 予約領域 */
+
+  static constexpr uint32_t current_version = 1;
+  static const char *magic_string() { return "CTRLLOG"; }
+};
+static_assert(sizeof(BinaryLogHeader) == 64, "unexpected header size");
+/* ヘッダと値をそのまま読み書きするので，リトルエンディアンに限る */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "binary log requires a little-endian target");
+#endif
+
+/**
+ * @brief バイナリ記録の書き出し器
+ *
+ * - 行をバッファに溜めて，一杯になるか flush() で std::ostream にまとめて
+ *   書き出す
+ * - close() (デストラクタ) で行の数をヘッダに書き戻す．シークできない
+ *   ストリームでは行の数は 0 のままとなり，読み出し側でファイルサイズから
+ *   求める
+ */
+class BinaryLogWriter {
+public:
+  /**
+   * @brief 列名1つあたりの大きさ [byte]
+   */
+  static constexpr uint32_t name_size = 16;
+
+public:
+  /**
+   * @brief コンストラクタ．ヘッダと列名を書き出す．
+   *
+   * @param os 書き出し先．バイナリモードで開いておくこと．
+   * @param names 列名のリスト (各 15 文字まで)
+   * @param buffer_rows バッファに溜める行の数
+   */
+  BinaryLogWriter(std::ostream &os, const std::vector<std::string> &names,
+                  const std::size_t buffer_rows = 4096)
+      : os(os), columns(names.size()), capacity(buffer_rows * names.size()) {
+    buffer.reserve(capacity);
+    BinaryLogHeader h{};
+    std::strncpy(h.magic, BinaryLogHeader::magic_string(), sizeof(h.magic));
+    h.version = BinaryLogHeader::current_version;
+    h.columns = uint32_t(columns);
+    h.name_size = name_size;
+    const auto names_end = sizeof(h) + name_size * columns;
+    h.data_offset = uint32_t((names_end + 63) / 64 * 64); //< 64 byte 境界
+    start = os.tellp();
+    os.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    for (const auto &name : names) {
+      char s[name_size] = {};
+      std::strncpy(s, name.c_str(), name_size - 1);
+      os.write(s, name_size);
+    }
+    const std::vector<char> pad(h.data_offset - names_end, 0);
+    os.write(pad.data(), pad.size());
+  }
+  /**
+   * @brief デストラクタ．close() を呼ぶ．
+   */
+  ~BinaryLogWriter() { close(); }
+  BinaryLogWriter(const BinaryLogWriter &) = delete;
+  BinaryLogWriter &operator=(const BinaryLogWriter &) = delete;
+  /**
+   * @brief 1行を追加する関数
+   *
+   * @param row 列の数だけの値
+   */
+  void push(const float *row) {
+    buffer.insert(buffer.end(), row, row + columns);
+    ++count;
+    if (buffer.size() >= capacity)
+      flush();
+  }
+  /**
+   * @brief 1行を追加する関数
+   *
+   * @return 追加できたか (値の数が列の数と異なれば追加せず false)
+   */
+  bool push(const std::initializer_list<float> row) {
+    if (row.size() != columns)
+      return false;
+    push(row.begin());
+    return true;
+  }
+  /**
+   * @brief バッファの内容を書き出す関数
+   */
+  void flush() {
+    os.write(reinterpret_cast<const char *>(buffer.data()),
+             buffer.size() * sizeof(float));
+    buffer.clear();
+  }
+  /**
+   * @brief バッファを書き出し，ヘッダの行の数を確定する関数
+   */
+  void close() {
+    flush();
+    if (start == std::streampos(-1))
+      return;
+    const auto end = os.tellp();
+    os.seekp(start + std::streamoff(offsetof(BinaryLogHeader, rows)));
+    os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    os.seekp(end);
+    os.flush();
+  }
+  /**
+   * @brief 追加された行の数
+   */
+  uint64_t size() const { return count; }
+
+protected:
+  std::ostream &os;          /**< @brief 書き出し先 */
+  std::size_t columns;       /**< @brief 列の数 */
+  std::size_t capacity;      /**< @brief バッファの大きさ [要素] */
+  std::vector<float> buffer; /**< @brief 書き出し待ちの行 */
+  uint64_t count = 0;        /**< @brief 行の数 */
+  std::streampos start;      /**< @brief ヘッダの位置 */
+};
+
+#if CTRL_BINARY_LOG_MMAP
+/**
+ * @brief バイナリ記録の読み出し器 (POSIX mmap)
+ *
+ * ファイルをメモリにマップするので，大きな記録も読み込みを待たずに
+ * 必要な部分だけ参照できる．
+ */
+class BinaryLogReader {
+public:
+  BinaryLogReader() {}
+  /**
+   * @brief ファイルを開くコンストラクタ．失敗は isOpen() で確認する．
+   */
+  explicit BinaryLogReader(const char *path) { open(path); }
+  ~BinaryLogReader() { close(); }
+  BinaryLogReader(const BinaryLogReader &) = delete;
+  BinaryLogReader &operator=(const BinaryLogReader &) = delete;
+  /**
+   * @brief ファイルを開く関数
+   *
+   * @return 開いて形式を確認できたか
+   */
+  bool open(const char *path) {
+    close();
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size >= off_t(sizeof(header))) {
+      size = std::size_t(st.st_size);
+      void *p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (p != MAP_FAILED)
+        base = static_cast<const char *>(p);
+    }
+    ::close(fd);
+    if (!base || !parse()) {
+      close();
+      return false;
+    }
+    return true;
+  }
+  /**
+   * @brief ファイルを閉じる関数
+   */
+  void close() {
+    if (base)
+      ::munmap(const_cast<char *>(base), size);
+    base = nullptr, data = nullptr;
+    size = 0, n_rows = 0;
+  }
+  bool isOpen() const { return base != nullptr; }
+  uint32_t columns() const { return header.columns; }
+  uint64_t rows() const { return n_rows; }
+  /**
+   * @brief 列名を取得する関数
+   */
+  std::string name(const uint32_t c) const {
+    const char *s = base + sizeof(header) + std::size_t(header.name_size) * c;
+    return std::string(s, strnlen(s, header.name_size));
+  }
+  /**
+   * @brief 列名から列の番号を得る関数．見つからなければ -1．
+   */
+  int find(const std::string &n) const {
+    for (uint32_t c = 0; c < header.columns; ++c)
+      if (name(c) == n)
+        return int(c);
+    return -1;
+  }
+  /**
+   * @brief i 行目の先頭
+   */
+  const float *row(const uint64_t i) const {
+    return data + std::size_t(i) * header.columns;
+  }
+  /**
+   * @brief r 行 c 列の値
+   */
+  float operator()(const uint64_t r, const uint32_t c) const {
+    return row(r)[c];
+  }
+
+protected:
+  BinaryLogHeader header{};    /**< @brief ヘッダの複製 */
+  const char *base = nullptr;  /**< @brief マップした先頭 */
+  const float *data = nullptr; /**< @brief データの先頭 */
+  std::size_t size = 0;        /**< @brief ファイルの大きさ [byte] */
+  uint64_t n_rows = 0;         /**< @brief 読み出せる行の数 */
+
+  /**
+   * @brief ヘッダを検査する関数
+   */
+  bool parse() {
+    std::memcpy(&header, base, sizeof(header));
+    if (std::strncmp(header.magic, BinaryLogHeader::magic_string(),
+                     sizeof(header.magic)) != 0 ||
+        header.version != BinaryLogHeader::current_version ||
+        header.columns == 0 || header.data_offset % sizeof(float) != 0 ||
+        header.data_offset > size ||
+        header.data_offset <
+            sizeof(header) + uint64_t(header.name_size) * header.columns)
+      return false;
+    data = reinterpret_cast<const float *>(base + header.data_offset);
+    /* 書き出しが中断された記録にも対応するため，ファイルサイズで制限 */
+    const uint64_t available =
+        (size - header.data_offset) / (sizeof(float) * header.columns);
+    n_rows = header.rows && header.rows < available ? header.rows : available;
+    return true;
+  }
+};
+#endif
+
+} // namespace ctrl
@@ -0,0 +1,163 @@
+/**
+ * @file csv_writer.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief バッファ付きの csv 書き出し器を定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief バッファ付きの csv 書き出し器
+ *
+ * - 数値を文字列に変換して大きなバッファに溜め，一杯に近づいたときと
+ *   flush() (デストラクタ) のときにまとめて std::ostream に書き出す
+ * - 行末は '\n' で，行ごとにストリームをフラッシュしない
+ * - 数値の変換は std::to_chars を用い，使えない環境 (C++14 など) では
+ *   snprintf を用いる．既定の書式は std::ostream の既定と同じ有効数字6桁
+ *
+ * @code {.cpp}
+ * ctrl::CsvWriter csv(os);
+ * for (float t = 0; t < t_end; t += Ts)
+ *   csv.row({t, ad.j(t), ad.a(t), ad.v(t), ad.x(t)});
+ * @endcode
+ */
+class CsvWriter {
+public:
+  /**
+   * @brief 1つの数値の最大文字数
+   */
+  static constexpr std::size_t field_size_max = 32;
+
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param os 書き出し先
+   * @param capacity バッファの大きさ [byte]
+   * @param precision 有効数字の桁数
+   */
+  explicit CsvWriter(std::ostream &os, const std::size_t capacity = 1 << 16,
+                     const int precision = 6)
+      : os(os), buffer(capacity < 2 * field_size_max ? 2 * field_size_max
+                                                     : capacity),
+        precision(precision) {}
+  /**
+   * @brief デストラクタ．flush() を呼ぶ．
+   */
+  ~CsvWriter() { flush(); }
+  CsvWriter(const CsvWriter &) = delete;
+  CsvWriter &operator=(const CsvWriter &) = delete;
+  /**
+   * @brief 現在の行に数値を追加する関数
+   */
+  void field(const float value) {
+    reserve();
+    if (!first)
+      buffer[size++] = ',';
+    first = false;
+    size += format(buffer.data() + size, value);
+  }
+  /**
+   * @brief 現在の行に文字列をそのまま追加する関数 (見出しなど)
+   */
+  void field(const char *text) {
+    if (!first)
+      put(",", 1);
+    first = false;
+    put(text, std::strlen(text));
+  }
+  /**
+   * @brief 現在の行を終える関数
+   */
+  void endRow() {
+    reserve();
+    buffer[size++] = '\n';
+    first = true;
+  }
+  /**
+   * @brief 数値の列を1行として書き出す関数
+   */
+  void row(const std::initializer_list<float> values) {
+    for (const auto v : values)
+      field(v);
+    endRow();
+  }
+  /**
+   * @brief バッファを書き出し，ストリームもフラッシュする関数
+   */
+  void flush() {
+    spill();
+    os.flush();
+  }
+
+protected:
+  std::ostream &os;         /**< @brief 書き出し先 */
+  std::vector<char> buffer; /**< @brief 書き出し待ちの文字列 */
+  std::size_t size = 0;     /**< @brief バッファの使用量 */
+  int precision;            /**< @brief 有効数字の桁数 */
+  bool first = true;        /**< @brief 行の先頭か */
+
+  /**
+   * @brief バッファの内容を書き出す関数 (ストリームはフラッシュしない)
+   */
+  void spill() {
+    os.write(buffer.data(), size);
+    size = 0;
+  }
+  /**
+   * @brief 区切り文字と数値1つ分の空きを確保する関数
+   */
+  void reserve() {
+    if (buffer.size() - size < field_size_max + 1)
+      spill();
+  }
+  /**
+   * @brief 任意の長さの文字列を追加する関数
+   */
+  void put(const char *s, std::size_t n) {
+    while (n > 0) {
+      if (size == buffer.size())
+        spill();
+      const auto k = std::min(n, buffer.size() - size);
+      std::memcpy(buffer.data() + size, s, k);
+      size += k, s += k, n -= k;
+    }
+  }
+  /**
+   * @brief 数値を書式化する関数
+   *
+   * @return 書き込んだ文字数
+   */
+  std::size_t format(char *p, const float value) const {
+#if defined(__cpp_lib_to_chars)
+    const auto res = std::to_chars(p, p + field_size_max, value,
+                                   std::chars_format::general, precision);
+    return std::size_t(res.ptr - p);
+#else
+    const int n = std::snprintf(p, field_size_max, "%.*g", precision,
+                                static_cast<double>(value));
+    return n < 0 ? 0 : std::size_t(n < int(field_size_max) ? n : 0);
+#endif
+  }
+};
+
+} // namespace ctrl
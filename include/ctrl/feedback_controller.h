@@ -59,7 +59,10 @@ public:
    * @param M フィードフォワードモデル
    * @param G フィードバックゲイン
    */
-  FeedbackController(const Model &M, const Gain &G) : M(M), G(G) { reset(); }
+  FeedbackController(const Model &M, const Gain &G) : G(G) {
+    setModel(M);
+    reset();
+  }
   /**
    * @brief 積分項をリセットする関数
    */
@@ -71,13 +74,15 @@ public:
    * @param y 観測値
    * @param dr 目標値の微分
    * @param dy 観測値の微分
-   * @param Ts 離散時間周期
+   * @param Ts 離散時間周期．T が固定小数点数の場合は，毎周期の変換を
+   * 避けるため事前に変換した T の値を渡すとよい．
    * @return T u 次ステップでの制御入力
    */
+  template <typename S = float>
   const T &update(const T &r, const T &y, const T &dr, const T &dy,
-                  const float Ts) {
+                  const S &Ts) {
     /* feedforward signal */
-    bd.ff = (M.T1 * dr + r) / M.K1;
+    bd.ff = T1_K1 * dr + K1_inv * r;
     /* feedback signal */
     bd.fbp = G.Kp * (r - y);
     bd.fbi = G.Ki * e_int;
@@ -90,6 +95,27 @@ public:
     /* complete */
     return bd.u;
   }
+  /**
+   * @brief 内訳を記録せずに状態を更新して，次の制御入力を得る関数
+   *
+   * 計算結果は update() と同じ．getBreakdown() の内容は更新されないので，
+   * 内訳を参照しない制御周期の処理で使用する．
+   *
+   * @param r 目標値
+   * @param y 観測値
+   * @param dr 目標値の微分
+   * @param dy 観測値の微分
+   * @param Ts 離散時間周期 (update() と同様)
+   * @return T u 次ステップでの制御入力
+   */
+  template <typename S = float>
+  T updateFast(const T &r, const T &y, const T &dr, const T &dy, const S &Ts) {
+    const auto e = r - y;
+    const auto u = T1_K1 * dr + K1_inv * r +
+                   (G.Kp * e + G.Ki * e_int + G.Kd * (dr - dy));
+    e_int += e * Ts;
+    return u;
+  }
   /**
    * @brief エラー積分値を取得
    */
@@ -101,7 +127,12 @@ public:
   /**
    * @brief フィードフォワードモデルを設定する関数
    */
-  void setModel(const Model &model) { M = model; }
+  void setModel(const Model &model) {
+    M = model;
+    /* 除算を避けるため係数を事前に計算; T(1) を持たない型にも対応 */
+    K1_inv = (M.K1 / M.K1) / M.K1;
+    T1_K1 = M.T1 / M.K1;
+  }
   /**
    * @brief フィードバックゲインを取得する関数
    */
@@ -120,6 +151,8 @@ protected:
   Gain G;       /**< @brief フィードバックゲイン */
   Breakdown bd; /**< @brief 制御入力の計算内訳 */
   T e_int;      /**< @brief 追従誤差の積分値 */
+  T K1_inv;     /**< @brief 定常ゲインの逆数 1 / K1 */
+  T T1_K1;      /**< @brief 時定数と定常ゲインの比 T1 / K1 */
 };
 
 }; // namespace ctrl
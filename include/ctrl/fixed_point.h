@@ -0,0 +1,218 @@
+/**
+ * @file fixed_point.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 飽和演算付きの固定小数点数型を定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief Q フォーマットの固定小数点数
+ *
+ * - 32 bit 符号付き整数の下位 Q bit を小数部とする
+ * - 演算は 64 bit の中間値で行い，範囲外の結果は最大値・最小値に飽和させる
+ * - FPU を持たないマイコンで FeedbackController<Fixed<Q>> などとして使う
+ * - float からは暗黙に変換できるので，定数やゲインは float で書ける
+ * - 積分器の増分 e * Ts が分解能を下回ると積分が止まるので，信号の単位は
+ *   値域に収まる範囲で大きくとること (Q15.16 では Ts = 1e-3 も 0.7% ずれる)
+ *
+ * @tparam Q 小数部のビット数
+ */
+template <int Q> class Fixed {
+  static_assert(0 < Q && Q < 31, "invalid number of fractional bits");
+
+public:
+  /**
+   * @brief 1 に相当する内部表現
+   */
+  static constexpr int32_t one = int32_t(1) << Q;
+
+public:
+  /**
+   * @brief 0 とするコンストラクタ
+   */
+  constexpr Fixed() : raw(0) {}
+  /**
+   * @brief 浮動小数点数からの変換 (四捨五入，飽和)
+   */
+  constexpr Fixed(const float f) : raw(saturate(f * one)) {}
+  /**
+   * @brief 内部表現から生成する関数
+   */
+  static constexpr Fixed fromRaw(const int32_t raw) {
+    return Fixed(raw, nullptr);
+  }
+  /**
+   * @brief 内部表現を取得する関数
+   */
+  constexpr int32_t getRaw() const { return raw; }
+  /**
+   * @brief 浮動小数点数への変換
+   */
+  constexpr float toFloat() const { return float(raw) / one; }
+  /**
+   * @brief 浮動小数点数への明示的な変換
+   */
+  constexpr explicit operator float() const { return toFloat(); }
+  /**
+   * @brief 表現できる最大値
+   */
+  static constexpr Fixed max() {
+    return fromRaw(std::numeric_limits<int32_t>::max());
+  }
+  /**
+   * @brief 表現できる最小値
+   */
+  static constexpr Fixed min() {
+    return fromRaw(std::numeric_limits<int32_t>::min());
+  }
+
+  Fixed &operator+=(const Fixed &o) { return *this = *this + o; }
+  Fixed &operator-=(const Fixed &o) { return *this = *this - o; }
+  Fixed &operator*=(const Fixed &o) { return *this = *this * o; }
+  Fixed &operator/=(const Fixed &o) { return *this = *this / o; }
+  friend Fixed operator+(const Fixed &a, const Fixed &b) {
+    return fromRaw(saturate(int64_t(a.raw) + b.raw));
+  }
+  friend Fixed operator-(const Fixed &a, const Fixed &b) {
+    return fromRaw(saturate(int64_t(a.raw) - b.raw));
+  }
+  friend Fixed operator*(const Fixed &a, const Fixed &b) {
+    const auto p = int64_t(a.raw) * b.raw;
+    return fromRaw(saturate((p + (int64_t(1) << (Q - 1))) >> Q)); //< 四捨五入
+  }
+  friend Fixed operator/(const Fixed &a, const Fixed &b) {
+    if (b.raw == 0)
+      return a.raw > 0 ? max() : a.raw < 0 ? min() : Fixed();
+    return fromRaw(saturate(int64_t(a.raw) * one / b.raw));
+  }
+  Fixed operator-() const { return fromRaw(saturate(-int64_t(raw))); }
+  friend bool operator==(const Fixed &a, const Fixed &b) {
+    return a.raw == b.raw;
+  }
+  friend bool operator!=(const Fixed &a, const Fixed &b) {
+    return a.raw != b.raw;
+  }
+  friend bool operator<(const Fixed &a, const Fixed &b) {
+    return a.raw < b.raw;
+  }
+  friend bool operator>(const Fixed &a, const Fixed &b) {
+    return a.raw > b.raw;
+  }
+  friend bool operator<=(const Fixed &a, const Fixed &b) {
+    return a.raw <= b.raw;
+  }
+  friend bool operator>=(const Fixed &a, const Fixed &b) {
+    return a.raw >= b.raw;
+  }
+  friend std::ostream &operator<<(std::ostream &os, const Fixed &o) {
+    return os << o.toFloat();
+  }
+
+protected:
+  int32_t raw; /**< @brief 内部表現 (値の 2^Q 倍) */
+
+  /**
+   * @brief 内部表現から生成するコンストラクタ
+   */
+  constexpr Fixed(const int32_t raw, std::nullptr_t) : raw(raw) {}
+  /**
+   * @brief 64 bit の中間値を 32 bit に飽和させる関数
+   */
+  static constexpr int32_t saturate(const int64_t x) {
+    return x > std::numeric_limits<int32_t>::max()   ? //
+               std::numeric_limits<int32_t>::max()
+           : x < std::numeric_limits<int32_t>::min() ? //
+               std::numeric_limits<int32_t>::min()
+                                                     : int32_t(x);
+  }
+  /**
+   * @brief 浮動小数点数を四捨五入して 32 bit に飽和させる関数
+   */
+  static constexpr int32_t saturate(const float x) {
+    return x >= 2147483520.0f    ? std::numeric_limits<int32_t>::max()
+           : x <= -2147483648.0f ? std::numeric_limits<int32_t>::min()
+                                 : int32_t(x + (x >= 0 ? 0.5f : -0.5f));
+  }
+};
+
+/**
+ * @brief Q15.16 フォーマット (範囲 ±32768, 分解能 1.5e-5)
+ */
+using Q16 = Fixed<16>;
+
+/**
+ * @brief 絶対値
+ */
+template <int Q> Fixed<Q> abs(const Fixed<Q> &x) {
+  return x.getRaw() < 0 ? -x : x;
+}
+/**
+ * @brief 平方根．整数の開平により計算する．負の値に対しては 0 を返す．
+ */
+template <int Q> Fixed<Q> sqrt(const Fixed<Q> &x) {
+  if (x.getRaw() <= 0)
+    return Fixed<Q>();
+  /* sqrt(raw * 2^Q) を桁ごとに求める */
+  uint64_t n = uint64_t(x.getRaw()) << Q;
+  uint64_t r = 0;
+  uint64_t bit = uint64_t(1) << 62;
+  while (bit > n)
+    bit >>= 2;
+  for (; bit != 0; bit >>= 2) {
+    if (n >= r + bit) {
+      n -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+  }
+  return Fixed<Q>::fromRaw(int32_t(r));
+}
+/**
+ * @brief 正弦関数
+ *
+ * 内部では Q30 の 64 bit 整数で計算する．[-pi, pi] に折り返したのち
+ * [-pi/2, pi/2] に対称移動し，7次の最良近似多項式で計算する．
+ * 誤差は 1e-5 程度．
+ */
+template <int Q> Fixed<Q> sin(const Fixed<Q> &x) {
+  constexpr int B = 30; //< 内部の小数部のビット数
+  constexpr int64_t one = int64_t(1) << B;
+  constexpr int64_t pi = 3373259426;     //< pi * 2^30
+  constexpr int64_t two_pi = 6746518852; //< 2 pi * 2^30
+  /* 係数 0.99999660, -0.16664824, 0.00830629, -0.00018363 の 2^30 倍 */
+  constexpr int64_t c1 = 1073738173, c3 = -178937185;
+  constexpr int64_t c5 = 8918811, c7 = -197171;
+  const auto mul = [](const int64_t a, const int64_t b) { return a * b >> B; };
+  /* [-pi, pi] に折り返す; k = round(x / 2pi) */
+  int64_t th = int64_t(x.getRaw()) * (int64_t(1) << (B - Q));
+  const auto k = (th + (th >= 0 ? pi : -pi)) / two_pi;
+  th -= k * two_pi;
+  /* [-pi/2, pi/2] に対称移動 */
+  if (th > pi / 2)
+    th = pi - th;
+  else if (th < -pi / 2)
+    th = -pi - th;
+  const auto th2 = mul(th, th);
+  const auto y = mul(th, c1 + mul(th2, c3 + mul(th2, c5 + mul(th2, c7))));
+  return Fixed<Q>::fromRaw(int32_t((y + (one >> (Q + 1))) >> (B - Q)));
+}
+/**
+ * @brief 余弦関数
+ */
+template <int Q> Fixed<Q> cos(const Fixed<Q> &x) {
+  constexpr Fixed<Q> half_pi = 1.57079633f;
+  return sin(x + half_pi);
+}
+
+} // namespace ctrl
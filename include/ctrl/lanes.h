@@ -0,0 +1,91 @@
+/**
+ * @file lanes.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 複数チャンネルの値を要素ごとに演算する型を定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <array>
+#include <cstddef> //< for std::size_t
+#include <ostream>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 複数チャンネル (レーン) の値をまとめた型
+ *
+ * - 四則演算はすべてレーンごとに行う
+ * - FeedbackController<Lanes<float, N>> とすると，車輪ごとや軸ごとの
+ *   N 個の制御器を1回の update() で計算できる
+ * - ループ長が定数なので，最適化によりベクトル命令に展開されやすい
+ *
+ * @tparam T 各レーンの型
+ * @tparam N レーンの数
+ */
+template <typename T, std::size_t N> struct Lanes {
+  alignas(16) std::array<T, N> v; /**< @brief 各レーンの値 */
+
+public:
+  /**
+   * @brief 全レーンを 0 とするコンストラクタ
+   */
+  constexpr Lanes() : v{} {}
+  /**
+   * @brief 各レーンの値を配列で指定するコンストラクタ
+   */
+  constexpr Lanes(const std::array<T, N> &v) : v(v) {}
+  /**
+   * @brief 各レーンの値を順に指定するコンストラクタ
+   */
+  template <typename... Args>
+  constexpr Lanes(const T &v0, const T &v1, const Args &...vs)
+      : v{{v0, v1, T(vs)...}} {
+    static_assert(sizeof...(Args) + 2 == N, "number of lanes mismatch");
+  }
+  /**
+   * @brief 全レーンを同じ値とするコンストラクタ
+   */
+  explicit Lanes(const T &value) { v.fill(value); }
+  T &operator[](const std::size_t i) { return v[i]; }
+  const T &operator[](const std::size_t i) const { return v[i]; }
+  static constexpr std::size_t size() { return N; }
+
+  Lanes &operator+=(const Lanes &o) {
+    for (std::size_t i = 0; i < N; ++i)
+      v[i] += o.v[i];
+    return *this;
+  }
+  Lanes &operator-=(const Lanes &o) {
+    for (std::size_t i = 0; i < N; ++i)
+      v[i] -= o.v[i];
+    return *this;
+  }
+  Lanes &operator*=(const Lanes &o) {
+    for (std::size_t i = 0; i < N; ++i)
+      v[i] *= o.v[i];
+    return *this;
+  }
+  Lanes &operator/=(const Lanes &o) {
+    for (std::size_t i = 0; i < N; ++i)
+      v[i] /= o.v[i];
+    return *this;
+  }
+  Lanes operator+(const Lanes &o) const { return Lanes(*this) += o; }
+  Lanes operator-(const Lanes &o) const { return Lanes(*this) -= o; }
+  Lanes operator*(const Lanes &o) const { return Lanes(*this) *= o; }
+  Lanes operator/(const Lanes &o) const { return Lanes(*this) /= o; }
+  Lanes operator*(const T &k) const { return *this * Lanes(k); }
+  Lanes operator/(const T &k) const { return *this / Lanes(k); }
+  Lanes operator-() const { return Lanes() - *this; }
+  friend std::ostream &operator<<(std::ostream &os, const Lanes &o) {
+    for (std::size_t i = 0; i < N; ++i)
+      os << (i ? ", " : "(") << o.v[i];
+    return os << ")";
+  }
+};
+
+} // namespace ctrl
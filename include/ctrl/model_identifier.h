@@ -0,0 +1,124 @@
+/**
+ * @file model_identifier.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 入出力の記録から1次モデルを同定するクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "feedback_controller.h"
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 逐次最小二乗法による1次モデルの同定器
+ *
+ * - 離散時間モデル $ y[k+1] = a y[k] + b u[k] $ の係数 a, b を，
+ *   記録された (u, y) の組を1つずつ push() して推定する
+ * - 保持するのは正規方程式の和のみなので，記録の長さによらずメモリは O(1)
+ * - 零次ホールドの関係 $ a = e^{-T_s/T_1},~ b = K_1 (1 - a) $ から
+ *   FeedbackController::Model の K1, T1 を求める
+ * - 長い記録でも桁落ちしないよう，和は double で保持する
+ *
+ * @code {.cpp}
+ * ctrl::ModelIdentifier mi;
+ * for (each logged row)
+ *   mi.push(u, y);
+ * ctrl::FeedbackController<float>::Model model;
+ * if (mi.estimate(model, Ts))
+ *   feedback_controller.setModel(model);
+ * @endcode
+ */
+class ModelIdentifier {
+public:
+  /**
+   * @brief 推定された離散時間モデルの係数
+   */
+  struct Coefficient {
+    double a; /**< 出力の係数 */
+    double b; /**< 入力の係数 */
+  };
+
+public:
+  /**
+   * @brief 空のコンストラクタ
+   */
+  ModelIdentifier() { reset(); }
+  /**
+   * @brief 蓄積した記録を破棄する関数
+   */
+  void reset() {
+    s_yy = s_yu = s_uu = s_yy1 = s_uy1 = 0;
+    count = 0;
+    y_prev = u_prev = 0;
+  }
+  /**
+   * @brief 制御周期ごとの記録を追加する関数
+   *
+   * @param u 制御入力 (次の周期の出力に作用する)
+   * @param y 観測出力
+   */
+  void push(const float u, const float y) {
+    const auto ud = double(u), yd = double(y);
+    if (count++ > 0) {
+      s_yy += y_prev * y_prev;
+      s_yu += y_prev * u_prev;
+      s_uu += u_prev * u_prev;
+      s_yy1 += y_prev * yd;
+      s_uy1 += u_prev * yd;
+    }
+    y_prev = yd, u_prev = ud;
+  }
+  /**
+   * @brief 追加された記録の数
+   */
+  uint64_t size() const { return count; }
+  /**
+   * @brief 離散時間モデルの係数を推定する関数
+   *
+   * @param c 推定結果の格納先
+   * @return 正規方程式が解けたか (入力が十分に励振されているか)
+   */
+  bool estimate(Coefficient &c) const {
+    const double det = s_yy * s_uu - s_yu * s_yu;
+    if (!(std::abs(det) > 1e-12 * s_yy * s_uu))
+      return false;
+    c.a = (s_uu * s_yy1 - s_yu * s_uy1) / det;
+    c.b = (s_yy * s_uy1 - s_yu * s_yy1) / det;
+    return true;
+  }
+  /**
+   * @brief フィードフォワードモデルを推定する関数
+   *
+   * @param model 推定結果の格納先
+   * @param Ts 記録の周期 [s]
+   * @return 推定結果が安定な1次モデルとなったか (0 < a < 1)
+   */
+  bool estimate(FeedbackController<float>::Model &model,
+                const float Ts) const {
+    Coefficient c;
+    if (!estimate(c) || !(0 < c.a && c.a < 1))
+      return false;
+    model.K1 = float(c.b / (1 - c.a));
+    model.T1 = float(-double(Ts) / std::log(c.a));
+    return true;
+  }
+
+protected:
+  double s_yy;    /**< @brief y[k] y[k] の和 */
+  double s_yu;    /**< @brief y[k] u[k] の和 */
+  double s_uu;    /**< @brief u[k] u[k] の和 */
+  double s_yy1;   /**< @brief y[k] y[k+1] の和 */
+  double s_uy1;   /**< @brief u[k] y[k+1] の和 */
+  uint64_t count; /**< @brief 記録の数 */
+  double y_prev;  /**< @brief 前回の出力 */
+  double u_prev;  /**< @brief 前回の入力 */
+};
+
+} // namespace ctrl
@@ -0,0 +1,318 @@
+/**
+ * @file path.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 直線とスラロームの列を1本の時刻付き軌道にまとめるクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_chain.h"
+#include "accel_designer.h"
+#include "pose.h"
+#include "slalom.h"
+#include "state.h"
+
+#include <algorithm> //< for std::min, std::upper_bound
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 経路関係の名前空間
+ */
+namespace path {
+
+/**
+ * @brief 経路を構成する動作
+ */
+struct Motion {
+  /**
+   * @brief 動作の種類
+   */
+  enum Type : uint8_t {
+    Straight, /**< @brief 直線 */
+    Turn,     /**< @brief スラローム */
+  };
+  Type type;                  /**< @brief 動作の種類 */
+  bool mirror;                /**< @brief ターンを左右反転するか */
+  float distance;             /**< @brief 直線の距離 [m] */
+  float velocity;             /**< @brief ターンの並進速度 [m/s] */
+  const slalom::Shape *shape; /**< @brief ターンの形状 */
+
+public:
+  /**
+   * @brief 直線．N 区画の直線は区画長の N 倍の距離を与える．
+   *
+   * @param distance 距離 [m]
+   */
+  static Motion straight(const float distance) {
+    return {Straight, false, distance, 0, nullptr};
+  }
+  /**
+   * @brief スラローム．形状の前後の直線も含む．
+   *
+   * @param shape スラローム形状．Trajectory::reset() の間のみ参照する．
+   * @param mirror 左右反転するか
+   * @param velocity 並進速度の上限 [m/s]．0 なら形状の基準速度 v_ref
+   */
+  static Motion turn(const slalom::Shape &shape, const bool mirror = false,
+                     const float velocity = 0) {
+    return {Turn, mirror, 0, velocity > 0 ? velocity : shape.v_ref, &shape};
+  }
+};
+
+/**
+ * @brief path::Trajectory 経路全体の軌道
+ *
+ * - 直線とスラロームの列から，時刻を通した1本の軌道を生成する
+ * - ターン前後の直線 (straight_prev, straight_post) は隣の直線に含め，
+ *   ターンの区間は曲線部分のみとする
+ * - 区間は連続した配列に並べ，区間の始点時刻の配列を二分探索して
+ *   O(log n) で任意の時刻の状態を得る
+ * - ターンの位置は生成時に数値積分し，時刻で等分した節点の位置と速度を
+ *   保持する．評価時は3次エルミート補間により，積分し直さない
+ */
+class Trajectory {
+public:
+  /**
+   * @brief ターン1つあたりの節点の区間数
+   */
+  static constexpr int knots_per_turn = 32;
+  /**
+   * @brief 軌道の区間
+   */
+  struct Segment {
+    AccelDesigner ad; /**< @brief 直線: 距離, ターン: 角度 (絶対) */
+    float x0, y0;     /**< @brief 始点位置 [m] */
+    float th0;        /**< @brief 始点姿勢 [rad] */
+    float c0, s0;     /**< @brief 始点姿勢の余弦・正弦 */
+    float v;          /**< @brief ターンの並進速度 [m/s] */
+    uint32_t knot;    /**< @brief ターンの先頭の節点の番号 */
+    bool turn;        /**< @brief ターンか */
+  };
+  /**
+   * @brief ターンの節点
+   */
+  struct Knot {
+    float x, y;   /**< @brief 位置 [m] */
+    float dx, dy; /**< @brief 速度 [m/s] */
+  };
+
+public:
+  /**
+   * @brief 空のコンストラクタ．あとで reset() により初期化すること．
+   */
+  Trajectory() {}
+  /**
+   * @brief 動作の列から軌道を生成する関数
+   *
+   * ターンは前後の直線をつなぐ等速の接続点とみなし，AccelChain により
+   * すべての接続速度を一括で求めてから各区間を1回ずつ生成する．
+   * ターンの速度は上限 (Motion::velocity と v_max の小さい方) を超えず，
+   * 直線は次の接続速度まで減速しきれる．ただし始点速度が速すぎて最初の
+   * ターンまでに減速しきれない場合は上限を超えるので，false を返す．
+   * ターンの速度は正であること (先頭のターンの前には直線を置く)．
+   *
+   * @param motions 動作の列
+   * @param j_max 直線の最大躍度の大きさ [m/s/s/s]
+   * @param a_max 直線の最大加速度の大きさ [m/s/s]
+   * @param v_max 直線の最大速度の大きさ [m/s]
+   * @param v_start 始点速度 [m/s]
+   * @param v_end 終点速度 [m/s]
+   * @param start 始点位置姿勢 (オプション)
+   * @param t_start 始点時刻 [s] (オプション)
+   * @return すべてのターンを速度の上限以下で通過できるか
+   */
+  bool reset(const std::vector<Motion> &motions, const float j_max,
+             const float a_max, const float v_max, const float v_start = 0,
+             const float v_end = 0, const Pose &start = Pose(),
+             const float t_start = 0) {
+    clear();
+    pose = start;
+    t = t_start;
+    /* ターンで区切った直線の距離と，接続点の速度の上限 */
+    std::vector<float> ds(1, 0);
+    std::vector<const Motion *> turns;
+    std::vector<float> vs(1, v_start);
+    for (const auto &m : motions) {
+      if (m.type == Motion::Straight) {
+        ds.back() += m.distance;
+        continue;
+      }
+      ds.back() += m.shape->straight_prev;
+      ds.push_back(m.shape->straight_post);
+      turns.push_back(&m);
+      vs.push_back(std::min(m.velocity, v_max));
+    }
+    vs.push_back(v_end);
+    AccelChain::planVelocities(j_max, a_max, ds.data(), vs.data(), ds.size());
+    /* 各区間を生成 */
+    float v = v_start; /*< 現在の速度 */
+    bool feasible = true;
+    for (std::size_t i = 0; i < turns.size(); ++i) {
+      v = pushStraight(j_max, a_max, v_max, v, vs[i + 1], ds[i]);
+      if (v > vs[i + 1] + 1e-3f * vs[i + 1]) {
+        ctrl_logw << "turn velocity exceeded: " << v << std::endl;
+        feasible = false;
+      }
+      pushTurn(*turns[i], v);
+    }
+    pushStraight(j_max, a_max, v_max, v, v_end, ds.back());
+    return feasible;
+  }
+  /**
+   * @brief 時刻 t [s] における状態を得る関数
+   */
+  void update(State &s, const float t) const {
+    if (segments.empty())
+      return;
+    const auto &seg = segments[index(t)];
+    if (seg.turn)
+      return updateTurn(seg, s, t);
+    const auto x = seg.ad.x(t), v = seg.ad.v(t);
+    const auto a = seg.ad.a(t), j = seg.ad.j(t);
+    s.q = Pose(seg.x0 + x * seg.c0, seg.y0 + x * seg.s0, seg.th0);
+    s.dq = Pose(v * seg.c0, v * seg.s0, 0);
+    s.ddq = Pose(a * seg.c0, a * seg.s0, 0);
+    s.dddq = Pose(j * seg.c0, j * seg.s0, 0);
+  }
+  /**
+   * @brief 時刻 t [s] における状態
+   */
+  State stateAt(const float t) const {
+    State s;
+    update(s, t);
+    return s;
+  }
+  /**
+   * @brief 時刻 t [s] の属する区間の番号
+   */
+  std::size_t index(const float t) const {
+    const auto it = std::upper_bound(ts.begin(), ts.end(), t);
+    return it == ts.begin() ? 0 : std::size_t(it - ts.begin() - 1);
+  }
+  /**
+   * @brief 始点時刻 [s]
+   */
+  float t_start() const { return ts.empty() ? t : ts.front(); }
+  /**
+   * @brief 終点時刻 [s]
+   */
+  float t_end() const { return t; }
+  /**
+   * @brief 終点位置姿勢
+   */
+  const Pose &getPoseEnd() const { return pose; }
+  /**
+   * @brief 区間の配列を取得
+   */
+  const std::vector<Segment> &getSegments() const { return segments; }
+  /**
+   * @brief 節点の配列を取得
+   */
+  const std::vector<Knot> &getKnots() const { return knots; }
+
+protected:
+  std::vector<float> ts;         /**< @brief 各区間の始点時刻 [s] */
+  std::vector<Segment> segments; /**< @brief 区間 */
+  std::vector<Knot> knots;       /**< @brief ターンの節点 */
+  Pose pose;                     /**< @brief 生成中の位置姿勢 */
+  float t = 0;                   /**< @brief 生成中の時刻 [s] */
+
+  /**
+   * @brief 軌道を空にする関数
+   */
+  void clear() {
+    ts.clear();
+    segments.clear();
+    knots.clear();
+  }
+  /**
+   * @brief 区間を追加する関数
+   */
+  Segment &push(const bool turn) {
+    Segment seg;
+    seg.x0 = pose.x, seg.y0 = pose.y, seg.th0 = pose.th;
+    seg.c0 = std::cos(pose.th), seg.s0 = std::sin(pose.th);
+    seg.v = 0, seg.knot = uint32_t(knots.size()), seg.turn = turn;
+    ts.push_back(t);
+    segments.push_back(seg);
+    return segments.back();
+  }
+  /**
+   * @brief 直線の区間を追加する関数
+   *
+   * @return 終点速度 [m/s]
+   */
+  float pushStraight(const float j_max, const float a_max, const float v_max,
+                     const float v_start, const float v_target,
+                     const float d) {
+    if (d <= 0)
+      return v_start;
+    auto &seg = push(false);
+    seg.ad.reset(j_max, a_max, v_max, v_start, v_target, d, 0, t);
+    pose.x += d * seg.c0;
+    pose.y += d * seg.s0;
+    t = seg.ad.t_end();
+    return seg.ad.v_end();
+  }
+  /**
+   * @brief ターンの区間を追加し，節点を積分する関数
+   */
+  void pushTurn(const Motion &m, const float v) {
+    auto &seg = push(true);
+    slalom::Trajectory st(*m.shape, m.mirror);
+    st.reset(v, pose.th, t);
+    seg.ad = st.getAccelDesigner();
+    seg.v = v;
+    /* 節点の間を細かく積分する */
+    const int substeps = 8;
+    const float h = (seg.ad.t_end() - t) / knots_per_turn;
+    const float Ts = h / substeps;
+    State s;
+    s.q = pose;
+    knots.push_back({pose.x, pose.y, v * seg.c0, v * seg.s0});
+    for (int i = 0; i < knots_per_turn; ++i) {
+      for (int k = 0; k < substeps; ++k)
+        st.update(s, t + h * float(i) + Ts * float(k), Ts);
+      knots.push_back({s.q.x, s.q.y, s.dq.x, s.dq.y});
+    }
+    pose = s.q;
+    t = seg.ad.t_end();
+  }
+  /**
+   * @brief ターンの区間の状態を得る関数
+   */
+  void updateTurn(const Segment &seg, State &s, const float t) const {
+    const auto &ad = seg.ad;
+    const float tt = std::max(ad.t_0(), std::min(t, ad.t_end()));
+    const float h = (ad.t_end() - ad.t_0()) / knots_per_turn;
+    const float u = h > 0 ? (tt - ad.t_0()) / h : 0;
+    const int i = std::max(0, std::min(int(u), knots_per_turn - 1));
+    const float r = u - float(i);
+    const auto &k0 = knots[seg.knot + i];
+    const auto &k1 = knots[seg.knot + i + 1];
+    /* 3次エルミート補間 */
+    const float h00 = (1 + 2 * r) * (1 - r) * (1 - r);
+    const float h10 = r * (1 - r) * (1 - r) * h;
+    const float h01 = r * r * (3 - 2 * r);
+    const float h11 = r * r * (r - 1) * h;
+    const float th = ad.x(t), w = ad.v(t), dw = ad.a(t);
+    s.q.x = h00 * k0.x + h10 * k0.dx + h01 * k1.x + h11 * k1.dx;
+    s.q.y = h00 * k0.y + h10 * k0.dy + h01 * k1.y + h11 * k1.dy;
+    s.q.th = th;
+    /* 微分は Shape::integrate と同じ関係式 */
+    s.dq = Pose(seg.v * std::cos(th), seg.v * std::sin(th), w);
+    s.ddq = Pose(-s.dq.y * w, s.dq.x * w, dw);
+    s.dddq = Pose(-s.ddq.y * w - s.dq.y * dw, s.ddq.x * w + s.dq.x * dw,
+                  ad.j(t));
+  }
+};
+
+} // namespace path
+} // namespace ctrl
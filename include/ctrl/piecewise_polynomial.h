@@ -0,0 +1,161 @@
+/**
+ * @file piecewise_polynomial.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 軌道を区間ごとの3次多項式の係数表として保持するクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <array>
+#include <cstddef> //< for std::size_t
+#include <ostream>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 区間ごとの3次多項式により表現された軌道
+ *
+ * - AccelCurve や AccelDesigner から生成し，係数表として保持する
+ * - 位置 $x(t)$ の係数を躍度・加速度・速度の計算にも共用する
+ * - 区間番号は境界時刻との比較の和で求めるので，評価に分岐がない
+ * - 係数表はそのまま記録・転送用の形式としても使用できる
+ * - CTRL_ACCEL_CONSTANT_TIME のときは AccelCurve も内部でこれを用いる
+ *
+ * @tparam N 境界時刻の数．区間の数は N + 1 となる．
+ */
+template <std::size_t N> class PiecewisePolynomial {
+public:
+  /**
+   * @brief 区間の多項式
+   * $x(t) = c_0 + c_1 (t-t_s) + c_2 (t-t_s)^2 + c_3 (t-t_s)^3$
+   */
+  struct Segment {
+    float t;                /**< @brief 基準時刻 $t_s$ [s] */
+    std::array<float, 4> c; /**< @brief 係数 */
+  };
+
+public:
+  /**
+   * @brief 空のコンストラクタ．あとで reset() により初期化すること．
+   */
+  PiecewisePolynomial() : ts{}, seg{} {}
+  /**
+   * @brief 軌道から係数表を生成するコンストラクタ
+   *
+   * @param a 軌道 (AccelCurve, AccelDesigner など)
+   */
+  template <typename A> explicit PiecewisePolynomial(const A &a) { reset(a); }
+  /**
+   * @brief 保存された係数表を代入するコンストラクタ
+   *
+   * @param ts 境界時刻 [s]
+   * @param seg 区間の多項式
+   */
+  PiecewisePolynomial(const std::array<float, N> &ts,
+                      const std::array<Segment, N + 1> &seg)
+      : ts(ts), seg(seg) {}
+  /**
+   * @brief 軌道から係数表を生成する．
+   *
+   * 軌道は getTimeStamp() により N 個の境界時刻を提供し，
+   * 各区間で3次以下の多項式であること．
+   *
+   * @param a 軌道 (AccelCurve, AccelDesigner など)
+   */
+  template <typename A> void reset(const A &a) {
+    ts = a.getTimeStamp();
+    for (std::size_t i = 0; i <= N; ++i) {
+      /* 区間の基準時刻と区間内部の時刻 */
+      const float t_s = ts[i == 0 ? 0 : i - 1];
+      const float t_in = i == 0   ? ts[0] - 1
+                         : i == N ? ts[N - 1] + 1
+                                  : (ts[i - 1] + ts[i]) / 2;
+      /* 基準時刻での Taylor 展開; 躍度は区間内で一定 */
+      seg[i] = {t_s, {{a.x(t_s), a.v(t_s), a.a(t_s) / 2, a.j(t_in) / 6}}};
+    }
+  }
+  /**
+   * @brief 時刻 t [s] における躍度 j [m/s/s/s]
+   */
+  float j(const float t) const { return 6 * seg[index(t)].c[3]; }
+  /**
+   * @brief 時刻 t [s] における加速度 a [m/s/s]
+   */
+  float a(const float t) const {
+    const auto &s = seg[index(t)];
+    return 2 * s.c[2] + 6 * s.c[3] * (t - s.t);
+  }
+  /**
+   * @brief 時刻 t [s] における速度 v [m/s]
+   */
+  float v(const float t) const {
+    const auto &s = seg[index(t)];
+    const auto dt = t - s.t;
+    return s.c[1] + (2 * s.c[2] + 3 * s.c[3] * dt) * dt;
+  }
+  /**
+   * @brief 時刻 t [s] における位置 x [m]
+   */
+  float x(const float t) const {
+    const auto &s = seg[index(t)];
+    const auto dt = t - s.t;
+    return s.c[0] + (s.c[1] + (s.c[2] + s.c[3] * dt) * dt) * dt;
+  }
+  /**
+   * @brief 終点時刻 [s]
+   */
+  float t_end() const { return ts[N - 1]; }
+  /**
+   * @brief 終点速度 [m/s]
+   */
+  float v_end() const { return seg[N].c[1]; }
+  /**
+   * @brief 終点位置 [m]
+   */
+  float x_end() const { return seg[N].c[0]; }
+  /**
+   * @brief 境界のタイムスタンプを取得
+   */
+  const std::array<float, N> &getTimeStamp() const { return ts; }
+  /**
+   * @brief 区間の多項式を取得
+   */
+  const std::array<Segment, N + 1> &getSegments() const { return seg; }
+  /**
+   * @brief 時刻 t [s] の属する区間番号を取得
+   */
+  int index(const float t) const {
+    int i = 0;
+    for (std::size_t k = 0; k < N; ++k)
+      i += t > ts[k];
+    return i;
+  }
+  /**
+   * @brief 係数表の表示 (1行に1区間; t_s,c0,c1,c2,c3)
+   */
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const PiecewisePolynomial &obj) {
+    for (const auto &s : obj.seg)
+      os << s.t << "," << s.c[0] << "," << s.c[1] << "," << s.c[2] << ","
+         << s.c[3] << std::endl;
+    return os;
+  }
+
+protected:
+  std::array<float, N> ts;        /**< @brief 境界時刻 [s] */
+  std::array<Segment, N + 1> seg; /**< @brief 区間の多項式 */
+};
+
+/**
+ * @brief AccelCurve の係数表 (境界時刻 4 個)
+ */
+using AccelCurvePolynomial = PiecewisePolynomial<4>;
+/**
+ * @brief AccelDesigner の係数表 (境界時刻 8 個)
+ */
+using AccelDesignerPolynomial = PiecewisePolynomial<8>;
+
+} // namespace ctrl
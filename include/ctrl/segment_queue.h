@@ -0,0 +1,271 @@
+/**
+ * @file segment_queue.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 計画スレッドから制御ループへ軌道の区間を受け渡す待ちなしキューを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_designer.h"
+#include "slalom.h"
+#include "state.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef> //< for std::size_t
+#include <cstdint>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 書き込み1者，読み出し1者の待ちなし (wait-free) リングバッファ
+ *
+ * - 要素は内部の配列に値で保持し，動的確保を行わない
+ * - push() と pop() はそれぞれ原子変数の読み書き数回のみで完了する
+ * - 書き込み側と読み出し側の添字は別のキャッシュラインに置く
+ *
+ * @tparam T 要素の型．既定構築と複製ができること．
+ * @tparam N 要素の数．2のべき乗であること．
+ */
+template <typename T, std::size_t N> class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+  SpscQueue() : head(0), tail(0) {}
+  /**
+   * @brief 要素を追加する関数．書き込み側の1者のみが呼ぶこと．
+   *
+   * @return 追加できたか (満杯なら false)
+   */
+  bool push(const T &value) {
+    const auto t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == N)
+      return false;
+    buffer[t & (N - 1)] = value;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  /**
+   * @brief 先頭の要素を取り出す関数．読み出し側の1者のみが呼ぶこと．
+   *
+   * @return 取り出せたか (空なら false)
+   */
+  bool pop(T &value) {
+    const auto h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+      return false;
+    value = buffer[h & (N - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  /**
+   * @brief 要素の数．相手側の操作と並行する場合は概数となる．
+   */
+  std::size_t size() const {
+    return tail.load(std::memory_order_acquire) -
+           head.load(std::memory_order_acquire);
+  }
+  /**
+   * @brief 最大の要素の数
+   */
+  std::size_t capacity() const { return N; }
+
+protected:
+  alignas(64) std::atomic<uint32_t> head; /**< @brief 読み出し位置 */
+  alignas(64) std::atomic<uint32_t> tail; /**< @brief 書き込み位置 */
+  alignas(64) std::array<T, N> buffer;    /**< @brief 要素 */
+};
+
+/**
+ * @brief 直線またはスラロームの軌道の区間
+ *
+ * - 時刻と距離は区間の始点を0とした局所的な値とする
+ * - 直線は straight::Trajectory，スラロームは slalom::Trajectory と同じ
+ *   状態を出力する．スラロームの評価に形状は不要なので，角速度の設計と
+ *   並進速度のみを保持する
+ */
+class TrajectorySegment {
+public:
+  /**
+   * @brief 区間の種類
+   */
+  enum Type : uint8_t {
+    Straight, /**< @brief 直線 */
+    Slalom,   /**< @brief スラローム */
+  };
+
+public:
+  /**
+   * @brief 空のコンストラクタ．長さ0の直線となる．
+   */
+  TrajectorySegment() : type(Straight), velocity(0) {}
+  /**
+   * @brief 直線の区間．ad は時刻0，位置0から始まること．
+   */
+  TrajectorySegment(const AccelDesigner &ad)
+      : type(Straight), ad(ad), velocity(0) {}
+  /**
+   * @brief スラロームの区間．st は時刻0から始まること．
+   */
+  TrajectorySegment(const slalom::Trajectory &st)
+      : type(Slalom), ad(st.getAccelDesigner()), velocity(st.getVelocity()) {}
+  /**
+   * @brief 局所時刻 t [s] における並進の移動距離 [m]
+   */
+  float x(const float t) const {
+    return type == Straight ? ad.x(t) : velocity * t;
+  }
+  /**
+   * @brief 局所時刻 t [s] における並進速度 [m/s]
+   */
+  float v(const float t) const {
+    return type == Straight ? ad.v(t) : velocity;
+  }
+  /**
+   * @brief 状態の更新 (straight::Trajectory, slalom::Trajectory と同じ)
+   *
+   * @param s 状態変数
+   * @param t 局所時刻 [s]
+   * @param Ts 積分時間 [s] (スラロームのみ使用)
+   */
+  void update(State &s, const float t, const float Ts) const {
+    if (type == Slalom)
+      return slalom::Shape::integrate(ad, s, velocity, t, Ts);
+    s.q = Pose(ad.x(t), 0, 0);
+    s.dq = Pose(ad.v(t), 0, 0);
+    s.ddq = Pose(ad.a(t), 0, 0);
+    s.dddq = Pose(ad.j(t), 0, 0);
+  }
+  /**
+   * @brief 区間の時間 [s]
+   */
+  float t_end() const { return ad.t_end(); }
+  /**
+   * @brief 区間の並進の移動距離 [m]
+   */
+  float x_end() const { return x(ad.t_end()); }
+  Type getType() const { return type; }
+  const AccelDesigner &getAccelDesigner() const { return ad; }
+
+protected:
+  Type type;        /**< @brief 区間の種類 */
+  AccelDesigner ad; /**< @brief 直線: 距離, スラローム: 角度 */
+  float velocity;   /**< @brief スラロームの並進速度 [m/s] */
+};
+
+/**
+ * @brief 軌道の区間の待ちなしキュー
+ *
+ * - 計画スレッドが push() で区間を積み，制御ループが制御周期ごとに
+ *   advance() を呼んで現在の区間を得る
+ * - 区間の終点を越えると，時刻と距離のオフセットを終点の値だけ進めて
+ *   次の区間に切り替える．制御周期の端数も次の区間に持ち越すので，
+ *   区間の境界で時刻と距離が途切れない
+ * - 次の区間が間に合わない場合は現在の区間を終点速度で外挿して待ち，
+ *   届いた時点の時刻と距離から次の区間を始める (getUnderruns() で計数)
+ * - 制御ループ側は動的確保もロックも行わない
+ *
+ * @tparam N キューに積める区間の数．2のべき乗であること．
+ */
+template <std::size_t N> class SegmentQueue {
+public:
+  SegmentQueue() { clear(); }
+  /**
+   * @brief 区間を追加する関数．計画スレッドの1者のみが呼ぶこと．
+   *
+   * @return 追加できたか (満杯なら false)
+   */
+  bool push(const TrajectorySegment &segment) { return queue.push(segment); }
+  /**
+   * @brief 時刻 t [s] の区間に進める関数．制御ループの1者のみが呼ぶこと．
+   *
+   * @return 現在の区間があるか
+   */
+  bool advance(const float t) {
+    if (!active) {
+      if (!queue.pop(current))
+        return false;
+      active = true, t_offset = t, x_offset = 0;
+    }
+    while (t - t_offset >= current.t_end()) {
+      TrajectorySegment next;
+      if (!queue.pop(next)) {
+        underruns += !starved;
+        starved = true;
+        break;
+      }
+      if (starved) {
+        /* 外挿していた位置から始める */
+        x_offset += current.x(t - t_offset);
+        t_offset = t;
+        starved = false;
+      } else {
+        x_offset += current.x_end();
+        t_offset += current.t_end();
+      }
+      current = next;
+    }
+    return true;
+  }
+  /**
+   * @brief 現在の区間の状態を得る関数 (局所座標)
+   */
+  void update(State &s, const float t, const float Ts) const {
+    current.update(s, t - t_offset, Ts);
+  }
+  /**
+   * @brief 時刻 t [s] における通算の移動距離 [m]
+   */
+  float x(const float t) const { return x_offset + current.x(t - t_offset); }
+  /**
+   * @brief 時刻 t [s] における並進速度 [m/s]
+   */
+  float v(const float t) const { return current.v(t - t_offset); }
+  /**
+   * @brief 状態を初期化する関数．どちらの側とも並行して呼ばないこと．
+   */
+  void clear() {
+    TrajectorySegment s;
+    while (queue.pop(s)) {
+    }
+    current = s;
+    active = starved = false;
+    t_offset = x_offset = 0;
+    underruns = 0;
+  }
+  /**
+   * @brief 現在の区間
+   */
+  const TrajectorySegment &getCurrent() const { return current; }
+  /**
+   * @brief 現在の区間の始点時刻 [s]
+   */
+  float getTimeOffset() const { return t_offset; }
+  /**
+   * @brief 現在の区間の始点までの通算の移動距離 [m]
+   */
+  float getDistanceOffset() const { return x_offset; }
+  /**
+   * @brief 次の区間が間に合わなかった回数
+   */
+  uint32_t getUnderruns() const { return underruns; }
+  /**
+   * @brief キューに積まれている区間の数 (概数)
+   */
+  std::size_t size() const { return queue.size(); }
+
+protected:
+  SpscQueue<TrajectorySegment, N> queue; /**< @brief 区間のキュー */
+  /* 以下は制御ループ側のみが触れる */
+  TrajectorySegment current; /**< @brief 現在の区間 */
+  float t_offset;            /**< @brief 現在の区間の始点時刻 [s] */
+  float x_offset;            /**< @brief 現在の区間の始点の距離 [m] */
+  uint32_t underruns;        /**< @brief 区間が間に合わなかった回数 */
+  bool active;               /**< @brief 区間を開始したか */
+  bool starved;              /**< @brief 次の区間を待っているか */
+};
+
+} // namespace ctrl
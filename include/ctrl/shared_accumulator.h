@@ -0,0 +1,185 @@
+/**
+ * @file shared_accumulator.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 割り込みとタスクの間で共有するデータの蓄積器を定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accumulator.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ctrl {
+
+/**
+ * @brief 書き込み1者，読み出し複数者で共有するデータの蓄積器
+ *
+ * - シーケンスロック (seqlock) により，読み出し側は割り込みを禁止せずに
+ *   一貫したデータを得る
+ * - 書き込み側 push() は待ちなし (wait-free) で，エンコーダや IMU の
+ *   割り込みから呼び出せる．書き込むのは1つの要素と先頭位置と
+ *   シーケンス番号のみで，S によらない
+ * - 読み出し側は必要な要素のみを読み，書き込みと重なった場合に読み直す．
+ *   書き込み側に割り込んで読み出すと完了しないので，読み出しは
+ *   書き込みより低い優先度で行うこと
+ * - リングバッファの各要素と先頭位置は原子変数の語として保持し，
+ *   relaxed アクセスのみで読み書きするので，読み書きが重なっても
+ *   C++ のメモリモデル上のデータ競合とならない
+ *
+ * @tparam T データの型．トリビアルにコピー可能であること．
+ * @tparam S 蓄積するデータの数
+ * @tparam A snapshot() で返す蓄積器の型 (Accumulator, RunningAccumulator)
+ */
+template <typename T, std::size_t S, typename A = Accumulator<T, S>>
+class SharedAccumulator {
+  static_assert(S > 0, "size must be positive");
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param value バッファ内の全データに代入する初期値
+   */
+  SharedAccumulator(const T &value = T()) : head(0), seq(0) {
+    for (auto &slot : buffer)
+      store(slot, value);
+  }
+  /**
+   * @brief 最新のデータを追加する関数．書き込み側の1者のみが呼ぶこと．
+   */
+  void push(const T &value) {
+    const auto h = wrap(head.load(std::memory_order_relaxed) + 1);
+    const auto s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed); //< 奇数: 書き込み中
+    std::atomic_thread_fence(std::memory_order_release);
+    store(buffer[h], value);
+    head.store(h, std::memory_order_relaxed);
+    seq.store(s + 2, std::memory_order_release);
+  }
+  /**
+   * @brief 一貫した状態の蓄積器に対して関数を評価する関数
+   *
+   * snapshot() で全要素を複製してから f を1回だけ評価する．
+   * 一部の要素のみを使う場合は operator[] や average() の方が速い．
+   *
+   * @param f 蓄積器を引数にとる関数
+   * @return f の返り値
+   */
+  template <typename F> auto read(F f) const -> decltype(f(A())) {
+    return f(snapshot());
+  }
+  /**
+   * @brief 蓄積器全体の複製を取得する関数
+   */
+  A snapshot() const {
+    std::array<T, S> values; //< [0] が最新
+    retry([&](const std::size_t h) {
+      for (std::size_t i = 0; i < S; ++i)
+        values[i] = load(buffer[wrap(S + h - i)]);
+    });
+    A a(values[S - 1]);
+    for (std::size_t i = S - 1; i-- > 0;)
+      a.push(values[i]);
+    return a;
+  }
+  /**
+   * @brief 直近 index 番目の値を取得するオペレータ
+   */
+  T operator[](const std::size_t index) const {
+    T value;
+    retry([&](const std::size_t h) {
+      value = load(buffer[wrap(S + h - index)]);
+    });
+    return value;
+  }
+  /**
+   * @brief 直近 n 個の平均を取得する関数 (Accumulator::average と同じ)
+   */
+  T average(const int n = S) const {
+    T sum;
+    retry([&](const std::size_t h) {
+      sum = T();
+      for (int i = 0; i < n; i++)
+        sum += load(buffer[wrap(S + h - i)]);
+    });
+    return sum / n;
+  }
+  /**
+   * @brief リングバッファのサイズを返す関数
+   */
+  std::size_t size() const { return S; }
+
+protected:
+  using Word = uint32_t; /**< @brief 共有する語の型 */
+  /**
+   * @brief 要素1つあたりの語の数
+   */
+  static constexpr std::size_t W =
+      (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+  using Slot = std::array<std::atomic<Word>, W>; /**< @brief 要素1つ */
+
+  std::array<Slot, S> buffer;    /**< @brief リングバッファ */
+  std::atomic<std::size_t> head; /**< @brief 最新の要素の位置 */
+  std::atomic<uint32_t> seq; /**< @brief シーケンス番号，奇数は書き込み中 */
+
+  /**
+   * @brief 書き込みと重ならなくなるまで読み出しを繰り返す関数
+   *
+   * @param f 先頭位置を引数にとり，要素を読み出す関数
+   */
+  template <typename F> void retry(F f) const {
+    for (;;) {
+      const auto s = seq.load(std::memory_order_acquire);
+      if (s & 1)
+        continue;
+      f(head.load(std::memory_order_relaxed));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load(std::memory_order_relaxed) == s)
+        return;
+    }
+  }
+  /**
+   * @brief 添字を [0, S) に折り返す関数
+   */
+  static std::size_t wrap(const std::size_t i) {
+    return (S & (S - 1)) == 0 ? i & (S - 1) : i % S;
+  }
+  /**
+   * @brief 値を要素の語に書き込む関数
+   */
+  static void store(Slot &slot, const T &value) {
+    const auto *p = reinterpret_cast<const unsigned char *>(&value);
+    for (std::size_t i = 0; i < W; ++i) {
+      Word w = 0;
+      std::memcpy(&w, p + i * sizeof(Word), bytes(i));
+      slot[i].store(w, std::memory_order_relaxed);
+    }
+  }
+  /**
+   * @brief 要素の語から値を読み出す関数
+   */
+  static T load(const Slot &slot) {
+    T value;
+    auto *p = reinterpret_cast<unsigned char *>(&value);
+    for (std::size_t i = 0; i < W; ++i) {
+      const Word w = slot[i].load(std::memory_order_relaxed);
+      std::memcpy(p + i * sizeof(Word), &w, bytes(i));
+    }
+    return value;
+  }
+  /**
+   * @brief i 番目の語が受け持つバイト数 (末尾の語は端数となる)
+   */
+  static std::size_t bytes(const std::size_t i) {
+    return i + 1 < W ? sizeof(Word) : sizeof(T) - i * sizeof(Word);
+  }
+};
+
+} // namespace ctrl
@@ -0,0 +1,175 @@
+/**
+ * @file trajectory_tracker_fixed.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 固定小数点数による独立2輪車の軌道追従コントローラ
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "fixed_point.h"
+#include "trajectory_tracker.h"
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 固定小数点数による独立2輪車の軌道追従フィードバック制御器
+ *
+ * - TrajectoryTracker と同じ制御則を Fixed<Q> で計算する
+ * - Q15.16 の範囲に収まるよう，内部では長さの単位を [m] とする
+ * - updateFixed() は入出力も固定小数点数で，浮動小数点演算を含まない
+ * - update() は TrajectoryTracker と同じ [mm] 単位の float の入出力をもち，
+ *   入出力の変換のみ浮動小数点演算を行う
+ *
+ * @tparam Q 小数部のビット数
+ */
+template <int Q = 16> class TrajectoryTrackerFixed {
+public:
+  using F = Fixed<Q>;                       /**< @brief 固定小数点数型 */
+  using Gain = TrajectoryTracker::Gain;     /**< @brief ゲイン */
+  using Result = TrajectoryTracker::Result; /**< @brief 計算結果 [mm] */
+  /**
+   * @brief 固定小数点数の位置姿勢 [m, rad]
+   */
+  struct FixedPose {
+    F x, y, th;
+  };
+  /**
+   * @brief 固定小数点数の並進と回転 [m, rad]
+   */
+  struct FixedPolar {
+    F tra, rot;
+  };
+  /**
+   * @brief 固定小数点数の計算結果 [m, rad]
+   */
+  struct FixedResult {
+    F v, w, dv, dw;
+  };
+  /**
+   * @brief 内部の長さの単位 [m/mm]
+   */
+  static constexpr float unit = 1e-3f;
+
+public:
+  /**
+   * @brief コンストラクタ
+   *
+   * @param gain 軌道追従フィードバックゲイン ([mm] 単位)
+   */
+  TrajectoryTrackerFixed(const Gain &gain)
+      : kx(gain.omega_n * gain.omega_n), kdx(2 * gain.zeta * gain.omega_n),
+        low_zeta(gain.low_zeta), low_b(gain.low_b / unit / unit) {}
+  /**
+   * @brief 状態の初期化
+   *
+   * @param vs 初期並進速度 [mm/s]
+   */
+  void reset(const float vs = 0) { xi = vs * unit; }
+  /**
+   * @brief 制御入力の計算 ([mm] 単位の float の入出力)
+   */
+  const Result update(const Pose &est_q, const Polar &est_v, const Polar &est_a,
+                      const State &ref_s) {
+    const auto r = updateFixed(
+        toFixed(est_q), toFixed(est_v), toFixed(est_a), toFixed(ref_s.q),
+        toFixed(ref_s.dq), toFixed(ref_s.ddq), toFixed(ref_s.dddq));
+    return {r.v.toFloat() / unit, r.w.toFloat(), r.dv.toFloat() / unit,
+            r.dw.toFloat()};
+  }
+  /**
+   * @brief 制御入力の計算 ([m] 単位の固定小数点数の入出力)
+   *
+   * @param est_q 推定位置
+   * @param est_v 推定速度
+   * @param est_a 推定加速度
+   * @param ref_q 目標位置
+   * @param ref_dq 目標速度
+   * @param ref_ddq 目標加速度
+   * @param ref_dddq 目標躍度
+   * @return const FixedResult 制御入力
+   */
+  const FixedResult
+  updateFixed(const FixedPose &est_q, const FixedPolar &est_v,
+              const FixedPolar &est_a, const FixedPose &ref_q,
+              const FixedPose &ref_dq, const FixedPose &ref_ddq,
+              const FixedPose &ref_dddq) {
+    constexpr F xi_threshold = TrajectoryTracker::xi_threshold * unit;
+    constexpr F two = 2.0f; //< 定数は実行時に float から変換しない
+    /* Ts は Q16 では誤差が大きいので，Q32 の係数を乗じて右シフトする */
+    constexpr int64_t Ts_q32 =
+        int64_t(double(TrajectoryTracker::Ts) * 4294967296.0 + 0.5);
+    /* Prepare Variable */
+    const F x = est_q.x;
+    const F y = est_q.y;
+    const F theta = est_q.th;
+    const F cos_theta = cos(theta);
+    const F sin_theta = sin(theta);
+    const F dx = est_v.tra * cos_theta;
+    const F dy = est_v.tra * sin_theta;
+    const F ddx = est_a.tra * cos_theta;
+    const F ddy = est_a.tra * sin_theta;
+    /* Determine Reference */
+    const F cos_th_r = cos(ref_q.th);
+    const F sin_th_r = sin(ref_q.th);
+    const F ex = ref_q.x - x;
+    const F ey = ref_q.y - y;
+    const F edx = ref_dq.x - dx;
+    const F edy = ref_dq.y - dy;
+    const F u1 = ref_ddq.x + kdx * edx + kx * ex;
+    const F u2 = ref_ddq.y + kdx * edy + kx * ey;
+    const F du1 = ref_dddq.x + kdx * (ref_ddq.x - ddx) + kx * edx;
+    const F du2 = ref_dddq.y + kdx * (ref_ddq.y - ddy) + kx * edy;
+    const F d_xi = u1 * cos_th_r + u2 * sin_th_r;
+    /* integral the state(s); 除算を避ける */
+    xi += F::fromRaw(int32_t(
+        (int64_t(d_xi.getRaw()) * Ts_q32 + (int64_t(1) << 31)) >> 32));
+    /* determine the output signal */
+    FixedResult res;
+    if (abs(xi) < xi_threshold) {
+      const F v_d = ref_dq.x * cos_th_r + ref_dq.y * sin_th_r;
+      const F w_d = ref_dq.th;
+      const F k1 = two * low_zeta * sqrt(w_d * w_d + low_b * v_d * v_d);
+      const F k2 = low_b;
+      const F k3 = k1;
+      const F eth = ref_q.th - theta;
+      res.v = v_d * cos(eth) + k1 * (cos_theta * ex + sin_theta * ey);
+      res.w = w_d + k2 * v_d * sinc(eth) * (cos_theta * ey - sin_theta * ex) +
+              k3 * eth;
+      res.dv = ref_ddq.x * cos_th_r + ref_ddq.y * sin_th_r;
+      res.dw = ref_ddq.th;
+    } else {
+      res.v = xi;
+      res.dv = d_xi;
+      res.w = (u2 * cos_th_r - u1 * sin_th_r) / xi;
+      res.dw =
+          -(two * d_xi * res.w + du1 * sin_th_r - du2 * cos_th_r) / xi;
+    }
+    return res;
+  }
+  /**
+   * @brief sinc(x) := sin(x) / x の固定小数点数版
+   */
+  static F sinc(const F &x) {
+    constexpr F one = 1.0f;
+    constexpr F c2 = -1.0f / 6, c4 = 1.0f / 120, c6 = -1.0f / 5040;
+    const auto xx = x * x;
+    return one + xx * (c2 + xx * (c4 + xx * c6));
+  }
+
+protected:
+  F xi;       /**< @brief 補助状態変数 [m/s] */
+  F kx;       /**< @brief 位置のフィードバックゲイン */
+  F kdx;      /**< @brief 速度のフィードバックゲイン */
+  F low_zeta; /**< @brief 低速時の減衰係数 */
+  F low_b;    /**< @brief 低速時のゲイン [1/m/m] */
+
+  static FixedPose toFixed(const Pose &p) {
+    return {p.x * unit, p.y * unit, p.th};
+  }
+  static FixedPolar toFixed(const Polar &p) { return {p.tra * unit, p.rot}; }
+};
+
+} // namespace ctrl
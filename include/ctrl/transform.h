@@ -0,0 +1,95 @@
+/**
+ * @file transform.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 回転を保持した平面上の剛体変換 SE(2) を定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "pose.h"
+
+#include <cmath>
+#include <ostream>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 平面上の剛体変換 SE(2)
+ *
+ * - 位置と，姿勢角の余弦・正弦の組 (単位複素数) を保持する
+ * - 合成は複素数の乗算で行うので，三角関数を評価するのは Pose からの
+ *   変換時の1回のみとなる
+ * - 姿勢角 th は回転の和として別に保持するので，1周を超えても連続となる
+ * - `a * b` は Pose の `b.homogeneous(a)` と同じ位置姿勢を表す
+ * - 長い合成を繰り返すと丸め誤差で回転の大きさが1からずれるので，
+ *   適宜 normalize() を呼ぶこと
+ */
+struct Transform {
+  float x;  /**< @brief x 成分 [m] */
+  float y;  /**< @brief y 成分 [m] */
+  float th; /**< @brief theta 成分 [rad] */
+  float c;  /**< @brief cos(th) */
+  float s;  /**< @brief sin(th) */
+
+public:
+  /**
+   * @brief 恒等変換とするコンストラクタ
+   */
+  Transform() : x(0), y(0), th(0), c(1), s(0) {}
+  /**
+   * @brief 位置姿勢からのコンストラクタ．三角関数を1回ずつ評価する．
+   */
+  Transform(const Pose &p)
+      : x(p.x), y(p.y), th(p.th), c(std::cos(p.th)), s(std::sin(p.th)) {}
+  /**
+   * @brief 位置姿勢への変換
+   */
+  Pose toPose() const { return {x, y, th}; }
+  /**
+   * @brief 逆変換
+   */
+  Transform inverse() const {
+    return {-c * x - s * y, s * x - c * y, -th, c, -s};
+  }
+  /**
+   * @brief 位置姿勢 p をこの変換の座標系から親の座標系へ写す関数
+   *
+   * Pose の `p.homogeneous(toPose())` と同じ結果を返す．
+   */
+  Pose apply(const Pose &p) const {
+    return {x + c * p.x - s * p.y, y + s * p.x + c * p.y, th + p.th};
+  }
+  /**
+   * @brief 回転の大きさを1に戻す関数
+   *
+   * 大きさが1に近いことを前提に，平方根を使わずニュートン法1回で補正する．
+   */
+  Transform &normalize() {
+    const float k = (3 - (c * c + s * s)) / 2;
+    return c *= k, s *= k, *this;
+  }
+  /**
+   * @brief 合成．o をこの変換の座標系で表された変換として後ろに繋げる．
+   */
+  Transform operator*(const Transform &o) const {
+    return {x + c * o.x - s * o.y, y + s * o.x + c * o.y, th + o.th,
+            c * o.c - s * o.s, s * o.c + c * o.s};
+  }
+  Transform &operator*=(const Transform &o) { return *this = *this * o; }
+  friend std::ostream &operator<<(std::ostream &os, const Transform &o) {
+    return os << "(" << o.x << ", " << o.y << ", " << o.th << ")";
+  }
+
+protected:
+  /**
+   * @brief 各成分を直接指定するコンストラクタ
+   */
+  Transform(const float x, const float y, const float th, const float c,
+            const float s)
+      : x(x), y(y), th(th), c(c), s(s) {}
+};
+
+} // namespace ctrl
@@ -0,0 +1,164 @@
+/**
+ * @file trigger_scheduler.h
+ * @author Ryotaro Onuki (kerikun11+github@gmail.com)
+ * @brief 軌道上の位置をトリガとしたイベントを制御周期ごとに発火するクラスを定義
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include "accel_designer.h"
+#include "slalom.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef> //< for std::size_t
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+/**
+ * @brief 制御関係の名前空間
+ */
+namespace ctrl {
+
+/**
+ * @brief 位置トリガのスケジューラ
+ *
+ * - センサ確認点や次の区間の再計画開始点など，位置 (角度) で指定された
+ *   イベントを制御周期ごとに発火する
+ * - reset() の時点で各トリガに到達する制御周期の番号 (tick) を
+ *   AccelDesigner::t() により求めておく
+ * - 制御周期ごとの poll() は整数の比較のみで済む
+ *
+ * @code {.cpp}
+ * ctrl::TriggerScheduler<4> ts;
+ * ts.reset(trajectory, {0.045f, 0.090f}, Ts);
+ * for (int k = 0; k < ticks; ++k)
+ *   for (int i; (i = ts.poll(k)) >= 0;)
+ *     onTrigger(i);
+ * @endcode
+ *
+ * @tparam N トリガの最大数
+ */
+template <std::size_t N> class TriggerScheduler {
+public:
+  /**
+   * @brief 発火時刻の型 [制御周期]
+   */
+  using Tick = int32_t;
+
+public:
+  /**
+   * @brief 空のコンストラクタ．トリガは空となる．
+   */
+  TriggerScheduler() { clear(); }
+  /**
+   * @brief 位置トリガを設定する関数
+   *
+   * 軌道の始点位置から見て単調に並んだトリガを与えること．
+   * N 個を超えたトリガは設定されない．
+   * 終点で停止する軌道 (v_end() == 0) では，区間 [始点, 終点] の外の
+   * トリガは到達しないので，そのトリガ以降は設定されない．
+   *
+   * @param ad 位置の軌道 (AccelDesigner, straight::Trajectory)
+   * @param first トリガ位置 [m] の先頭
+   * @param last トリガ位置 [m] の末尾
+   * @param Ts 制御周期 [s]
+   * @param t_origin tick 0 に対応する時刻 [s]
+   * @return すべてのトリガを設定できたか
+   *         (N 個を超えた場合や到達しないトリガがある場合は false)
+   */
+  template <typename Iterator>
+  bool reset(const AccelDesigner &ad, Iterator first, const Iterator last,
+             const float Ts, const float t_origin = 0) {
+    clear();
+    const auto x_start = ad.x(ad.t_0());
+    const auto x_min = std::min(x_start, ad.x_end());
+    const auto x_max = std::max(x_start, ad.x_end());
+    for (; first != last && size < N; ++first) {
+      const float x = *first;
+      if (ad.v_end() == 0 && !(x_min <= x && x <= x_max))
+        break; //< 停止する軌道では区間外の位置に到達しない
+      const auto t = ad.t(x);
+      if (std::isnan(t))
+        break;
+      ticks[size++] = toTick(t, Ts, t_origin);
+    }
+    return first == last;
+  }
+  /**
+   * @brief 位置トリガを設定する関数
+   *
+   * @param ad 位置の軌道 (AccelDesigner, straight::Trajectory)
+   * @param xs トリガ位置 [m] の昇順 (後退時は降順) のリスト
+   * @param Ts 制御周期 [s]
+   * @param t_origin tick 0 に対応する時刻 [s]
+   * @return すべてのトリガを設定できたか
+   */
+  bool reset(const AccelDesigner &ad, const std::initializer_list<float> xs,
+             const float Ts, const float t_origin = 0) {
+    return reset(ad, xs.begin(), xs.end(), Ts, t_origin);
+  }
+  /**
+   * @brief 角度トリガを設定する関数
+   *
+   * @param st スラローム軌道．reset() 済みであること．
+   * @param ths トリガ角度 [rad] のリスト
+   * @param Ts 制御周期 [s]
+   * @param t_origin tick 0 に対応する時刻 [s]
+   * @return すべてのトリガを設定できたか
+   */
+  bool reset(const slalom::Trajectory &st,
+             const std::initializer_list<float> ths, const float Ts,
+             const float t_origin = 0) {
+    return reset(st.getAccelDesigner(), ths.begin(), ths.end(), Ts, t_origin);
+  }
+  /**
+   * @brief トリガをすべて破棄する関数
+   */
+  void clear() { size = next = 0; }
+  /**
+   * @brief 制御周期ごとに呼び出して，発火したトリガを得る関数
+   *
+   * 同じ周期に複数のトリガが発火する場合は，-1 が返るまで繰り返し呼ぶこと．
+   *
+   * @param tick 現在の制御周期の番号
+   * @return 発火したトリガの番号．発火しない場合は -1
+   */
+  int poll(const Tick tick) {
+    if (next >= size || tick < ticks[next])
+      return -1;
+    return int(next++);
+  }
+  /**
+   * @brief 未発火のトリガの数
+   */
+  std::size_t pending() const { return size - next; }
+  /**
+   * @brief トリガの発火する制御周期の番号を取得
+   */
+  Tick getTick(const std::size_t i) const { return ticks[i]; }
+
+protected:
+  std::array<Tick, N> ticks; /**< @brief 発火周期 */
+  std::size_t size;          /**< @brief トリガの数 */
+  std::size_t next;          /**< @brief 次に発火するトリガの番号 */
+
+  /**
+   * @brief 時刻を，その時刻以降で最初の制御周期の番号に変換する関数
+   *
+   * Tick の範囲外となる時刻は範囲の端に丸め，NaN は発火しない最大値とする．
+   */
+  static Tick toTick(const float t, const float Ts, const float t_origin) {
+    const float k = std::ceil((t - t_origin) / Ts);
+    /* float(max) は 2^31 に丸められるので，未満でなければ最大値とする */
+    if (!(k < float(std::numeric_limits<Tick>::max())))
+      return std::numeric_limits<Tick>::max();
+    if (k <= float(std::numeric_limits<Tick>::min()))
+      return std::numeric_limits<Tick>::min();
+    return Tick(k);
+  }
+};
+
+} // namespace ctrl
@@ -6,16 +6,359 @@
  * @copyright Copyright (c) 2020 Ryotaro Onuki
  */
 #include <ctrl/accel_designer.h>
+#include <ctrl/accumulator.h>
+#include <ctrl/feedback_controller.h>
+#include <ctrl/polar.h>
 #include <ctrl/slalom.h>
+#include <ctrl/straight.h>
+#include <ctrl/trajectory_tracker.h>
+#include <ctrl/transform.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace py = pybind11;
+
+/**
+ * @brief C 連続な float の numpy 配列 (必要なら変換される)
+ */
+using FloatArray =
+    py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+/**
+ * @brief 時刻の配列に対して関数 F を評価し，同じ形の float 配列を返す関数
+ *
+ * 要素ごとに Python を経由しないよう，バッファを直接読み書きする．
+ * 入力は float32 と float64 のどちらでも複製せずに読む．
+ */
+template <typename C, float (C::*F)(float) const, typename A>
+FloatArray evaluate(const C &obj, const A &t) {
+  FloatArray res(std::vector<py::ssize_t>(t.shape(), t.shape() + t.ndim()));
+  const auto *in = t.data();
+  auto *out = res.mutable_data();
+  const auto n = t.size();
+  py::gil_scoped_release release;
+  for (py::ssize_t i = 0; i < n; ++i)
+    out[i] = (obj.*F)(float(in[i]));
+  return res;
+}
+
+/**
+ * @brief 時刻 t が numpy 配列または列なら配列で，数値なら float で評価する
+ *
+ * スカラー版と配列版を別の多重定義にすると，変換を許す2回目の照合で
+ * 0次元や要素数1の float64 配列がスカラー版に渡り，dtype と長さによって
+ * 戻り値の型が変わる．型で明示的に振り分けて，配列には常に配列を返す．
+ * C 連続な float64 配列はそのまま読み，それ以外は float32 に変換する．
+ */
+template <typename C, float (C::*F)(float) const>
+py::object evaluateAny(const C &obj, const py::object &t) {
+  using DoubleArray = py::array_t<double, py::array::c_style>;
+  if (py::isinstance<DoubleArray>(t))
+    return evaluate<C, F>(obj, t.cast<DoubleArray>());
+  if (py::isinstance<py::array>(t) || py::isinstance<py::sequence>(t))
+    return evaluate<C, F>(obj, t.cast<FloatArray>());
+  return py::float_((obj.*F)(t.cast<float>()));
+}
+
+/**
+ * @brief 周期 Ts で軌道を標本化し，(t, j, a, v, x) を列とする (N, 5)
+ *        の配列を返す関数
+ */
+template <typename C> FloatArray sample(const C &obj, const float Ts) {
+  if (!(Ts > 0))
+    throw py::value_error("Ts must be positive");
+  const auto t0 = obj.t_0(), t_end = obj.t_end();
+  const auto n = py::ssize_t(std::max(0.0f, std::ceil((t_end - t0) / Ts)));
+  FloatArray res({n, py::ssize_t(5)});
+  auto *out = res.mutable_data();
+  py::gil_scoped_release release;
+  for (py::ssize_t i = 0; i < n; ++i, out += 5) {
+    const float t = t0 + i * Ts;
+    out[0] = t, out[1] = obj.j(t), out[2] = obj.a(t);
+    out[3] = obj.v(t), out[4] = obj.x(t);
+  }
+  return res;
+}
+
+/**
+ * @brief 一括設計した AccelDesigner の結果
+ */
+struct AccelRecord {
+  float t_end;         /**< @brief 終点時刻 [s] */
+  float v_end;         /**< @brief 終点速度 [m/s] */
+  float x_end;         /**< @brief 終点位置 [m] */
+  float time_stamp[8]; /**< @brief 境界のタイムスタンプ [s] */
+};
+/**
+ * @brief 一括設計した slalom::Shape の結果
+ */
+struct ShapeRecord {
+  float v_ref;         /**< @brief カーブ部分の基準速度 [m/s] */
+  float straight_prev; /**< @brief カーブ前の直線の距離 [m] */
+  float straight_post; /**< @brief カーブ後の直線の距離 [m] */
+  float curve_x;       /**< @brief カーブ部分の移動位置 x [m] */
+  float curve_y;       /**< @brief カーブ部分の移動位置 y [m] */
+  float curve_th;      /**< @brief カーブ部分の移動姿勢 [rad] */
+  float t_curve;       /**< @brief 基準速度でのカーブ部分の所要時間 [s] */
+};
+PYBIND11_NUMPY_DTYPE(AccelRecord, t_end, v_end, x_end, time_stamp);
+PYBIND11_NUMPY_DTYPE(ShapeRecord, v_ref, straight_prev, straight_post,
+                     curve_x, curve_y, curve_th, t_curve);
+
+/**
+ * @brief 一括設計の引数．長さ1の配列は全要素に共通の値として扱う．
+ */
+class BatchParam {
+public:
+  BatchParam(const FloatArray &a)
+      : p(a.data()), n(a.size()), step(a.size() != 1) {}
+  float operator[](const py::ssize_t i) const { return p[i * step]; }
+  py::ssize_t size() const { return n; }
+
+private:
+  const float *p;   /**< @brief 配列の先頭 */
+  py::ssize_t n;    /**< @brief 配列の要素数 */
+  py::ssize_t step; /**< @brief 要素の間隔 (共通の値なら 0) */
+};
+
+/**
+ * @brief 引数の配列の長さを揃えて要素数を得る関数
+ */
+py::ssize_t batchSize(const std::initializer_list<const BatchParam *> ps) {
+  py::ssize_t n = 1;
+  for (const auto *p : ps)
+    if (p->size() != 1)
+      n = p->size();
+  for (const auto *p : ps)
+    if (p->size() != 1 && p->size() != n)
+      throw py::value_error("parameter arrays must have the same length");
+  return n;
+}
+
+/**
+ * @brief GIL を解放し，[0, n) を threads 個のスレッドで分担して f を実行する
+ *
+ * @param threads スレッド数．0 のときはハードウェアの並列数
+ */
+template <typename F>
+void parallelFor(const py::ssize_t n, unsigned threads, const F &f) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  if (py::ssize_t(threads) > n)
+    threads = unsigned(std::max<py::ssize_t>(1, n));
+  const auto chunk = [&](const unsigned k) {
+    for (py::ssize_t i = n * k / threads; i < n * (k + 1) / threads; ++i)
+      f(i);
+  };
+  py::gil_scoped_release release;
+  std::vector<std::thread> pool;
+  for (unsigned k = 1; k < threads; ++k)
+    pool.emplace_back(chunk, k);
+  chunk(0);
+  for (auto &th : pool)
+    th.join();
+}
+
+/**
+ * @brief AccelDesigner を一括で設計する関数
+ */
+py::array_t<AccelRecord>
+designAccel(const FloatArray &j_max_a, const FloatArray &a_max_a,
+            const FloatArray &v_max_a, const FloatArray &v_start_a,
+            const FloatArray &v_target_a, const FloatArray &dist_a,
+            const unsigned threads) {
+  const BatchParam j_max(j_max_a), a_max(a_max_a), v_max(v_max_a);
+  const BatchParam v_start(v_start_a), v_target(v_target_a), dist(dist_a);
+  const auto n =
+      batchSize({&j_max, &a_max, &v_max, &v_start, &v_target, &dist});
+  py::array_t<AccelRecord> res(n);
+  auto *out = res.mutable_data();
+  parallelFor(n, threads, [&](const py::ssize_t i) {
+    const ctrl::AccelDesigner ad(j_max[i], a_max[i], v_max[i], v_start[i],
+                                 v_target[i], dist[i]);
+    auto &r = out[i];
+    r.t_end = ad.t_end(), r.v_end = ad.v_end(), r.x_end = ad.x_end();
+    const auto ts = ad.getTimeStamp();
+    std::copy(ts.begin(), ts.end(), r.time_stamp);
+  });
+  return res;
+}
+
+/**
+ * @brief slalom::Shape を一括で設計する関数
+ */
+py::array_t<ShapeRecord>
+designShape(const FloatArray &x_a, const FloatArray &y_a,
+            const FloatArray &th_a, const FloatArray &y_curve_end_a,
+            const FloatArray &x_adv_a, const unsigned threads) {
+  const BatchParam x(x_a), y(y_a), th(th_a);
+  const BatchParam y_curve_end(y_curve_end_a), x_adv(x_adv_a);
+  const auto n = batchSize({&x, &y, &th, &y_curve_end, &x_adv});
+  py::array_t<ShapeRecord> res(n);
+  auto *out = res.mutable_data();
+  parallelFor(n, threads, [&](const py::ssize_t i) {
+    const ctrl::slalom::Shape shape(ctrl::Pose(x[i], y[i], th[i]),
+                                    y_curve_end[i], x_adv[i]);
+    ctrl::slalom::Trajectory st(shape);
+    st.reset(shape.v_ref);
+    auto &r = out[i];
+    r.v_ref = shape.v_ref;
+    r.straight_prev = shape.straight_prev;
+    r.straight_post = shape.straight_post;
+    r.curve_x = shape.curve.x, r.curve_y = shape.curve.y;
+    r.curve_th = shape.curve.th;
+    r.t_curve = st.getTimeCurve();
+  });
+  return res;
+}
+
+/**
+ * @brief 閉ループ走行の模擬
+ *
+ * 区間 (straight::Trajectory または slalom::Trajectory) のリストを順に
+ * 目標軌道とし，TrajectoryTracker と並進・回転の FeedbackController で
+ * 1次遅れ系の独立2輪車を制御する．制御周期は TrajectoryTracker::Ts．
+ * 各周期の記録を numpy 配列の dict で返す．
+ */
+py::dict simulate(const py::list &segments,
+                  const ctrl::FeedbackController<float> &fc_tra,
+                  const ctrl::FeedbackController<float> &fc_rot,
+                  const ctrl::FeedbackController<float>::Model &plant_tra,
+                  const ctrl::FeedbackController<float>::Model &plant_rot,
+                  const ctrl::TrajectoryTracker::Gain &tracker_gain) {
+  using namespace ctrl;
+  /* GIL の解放前に区間を複製する */
+  std::vector<straight::Trajectory> straights;
+  std::vector<slalom::Trajectory> slaloms;
+  std::vector<bool> is_straight;
+  for (const auto &seg : segments) {
+    if (py::isinstance<straight::Trajectory>(seg))
+      straights.push_back(seg.cast<straight::Trajectory>());
+    else if (py::isinstance<slalom::Trajectory>(seg))
+      slaloms.push_back(seg.cast<slalom::Trajectory>());
+    else
+      throw py::type_error("segments must be StraightTrajectory or "
+                           "Trajectory");
+    is_straight.push_back(py::isinstance<straight::Trajectory>(seg));
+  }
+  /* 記録: t, ref q (3), q (3), v, w, cmd (4), u (2) */
+  constexpr std::size_t C = 15;
+  std::vector<float> rows;
+  {
+    py::gil_scoped_release release;
+    const float Ts = TrajectoryTracker::Ts;
+    TrajectoryTracker tt(tracker_gain);
+    auto ft = fc_tra, fr = fc_rot;
+    const float a_tra = plant_tra.T1 > 0 ? std::exp(-Ts / plant_tra.T1) : 0;
+    const float a_rot = plant_rot.T1 > 0 ? std::exp(-Ts / plant_rot.T1) : 0;
+    State ref;         //< 目標状態
+    Pose q;            //< 実際の位置姿勢
+    Polar v, dv;       //< 実際の速度と加速度
+    float t_total = 0; //< 走行開始からの時刻
+    std::size_t i_straight = 0, i_slalom = 0;
+    tt.reset(), ft.reset(), fr.reset();
+    const auto step = [&](const float t) {
+      const auto cmd = tt.update(q, v, dv, ref);
+      const float u_tra = ft.update(cmd.v, v.tra, cmd.dv, dv.tra, Ts);
+      const float u_rot = fr.update(cmd.w, v.rot, cmd.dw, dv.rot, Ts);
+      rows.insert(rows.end(), {t, ref.q.x, ref.q.y, ref.q.th, q.x, q.y, q.th,
+                               v.tra, v.rot, cmd.v, cmd.w, cmd.dv, cmd.dw,
+                               u_tra, u_rot});
+      /* 1次遅れ系の速度応答と運動学 */
+      q.x += v.tra * std::cos(q.th) * Ts;
+      q.y += v.tra * std::sin(q.th) * Ts;
+      q.th += v.rot * Ts;
+      const auto v_next =
+          Polar(a_tra * v.tra + (1 - a_tra) * plant_tra.K1 * u_tra,
+                a_rot * v.rot + (1 - a_rot) * plant_rot.K1 * u_rot);
+      dv = (v_next - v) / Ts;
+      v = v_next;
+    };
+    for (const bool s : is_straight) {
+      if (s) {
+        const auto &st = straights[i_straight++];
+        const Transform origin(ref.q);
+        for (int k = 0; st.t_0() + k * Ts < st.t_end(); ++k) {
+          const float t = st.t_0() + k * Ts;
+          State ls;
+          st.update(ls, t);
+          ref.q = origin.apply(ls.q);
+          ref.dq = ls.dq.rotate(origin.th);
+          ref.ddq = ls.ddq.rotate(origin.th);
+          ref.dddq = ls.dddq.rotate(origin.th);
+          step(t_total + k * Ts);
+        }
+        t_total += st.t_end() - st.t_0();
+      } else {
+        auto sl = slaloms[i_slalom++];
+        sl.reset(sl.getVelocity(), ref.q.th);
+        for (int k = 0; k * Ts < sl.getTimeCurve(); ++k) {
+          sl.update(ref, k * Ts, Ts);
+          step(t_total + k * Ts);
+        }
+        t_total += sl.getTimeCurve();
+      }
+    }
+  }
+  /* 列ごとの numpy 配列に分ける */
+  const auto n = py::ssize_t(rows.size() / C);
+  const auto column = [&](const std::size_t c0, const std::size_t nc) {
+    FloatArray a = nc == 1 ? FloatArray(n) : FloatArray({n, py::ssize_t(nc)});
+    auto *out = a.mutable_data();
+    for (py::ssize_t i = 0; i < n; ++i)
+      for (std::size_t c = 0; c < nc; ++c)
+        *out++ = rows[i * C + c0 + c];
+    return a;
+  };
+  py::dict res;
+  res["t"] = column(0, 1);
+  res["ref"] = column(1, 3);
+  res["q"] = column(4, 3);
+  res["v"] = column(7, 2);
+  res["cmd"] = column(9, 4);
+  res["u"] = column(13, 2);
+  return res;
+}
+
+/**
+ * @brief Accumulator<float, S> のラッパーを定義する関数
+ */
+template <std::size_t S> void bindAccumulator(py::module &m) {
+  using A = ctrl::Accumulator<float, S>;
+  const auto name = "Accumulator" + std::to_string(S);
+  py::class_<A>(m, name.c_str())
+      .def(py::init<float>(), py::arg("value") = 0.0f)
+      .def("clear", &A::clear, py::arg("value") = 0.0f)
+      .def("push", py::overload_cast<const float &>(&A::push))
+      .def("push",
+           [](A &obj, const FloatArray &data) {
+             obj.push(data.data(), std::size_t(data.size()));
+           })
+      .def("__getitem__",
+           [](const A &obj, const std::size_t i) {
+             if (i >= S)
+               throw py::index_error();
+             return obj[i];
+           })
+      .def("__len__", &A::size)
+      .def("size", &A::size)
+      .def("average", &A::average, py::arg("n") = int(S))
+      //
+      ;
+}
 
 PYBIND11_MODULE(ctrl, m) {
-  namespace py = pybind11;
   using namespace ctrl;
 
   m.doc() = "MicroMouse Control Module";
@@ -24,10 +367,11 @@ PYBIND11_MODULE(ctrl, m) {
       .def(py::init<>())
       .def(py::init<float, float, float, float>())
       .def("reset", &AccelCurve::reset)
-      .def("j", &AccelCurve::j)
-      .def("a", &AccelCurve::a)
-      .def("v", &AccelCurve::v)
-      .def("x", &AccelCurve::x)
+      .def("j", &evaluateAny<AccelCurve, &AccelCurve::j>, py::arg("t"))
+      .def("a", &evaluateAny<AccelCurve, &AccelCurve::a>, py::arg("t"))
+      .def("v", &evaluateAny<AccelCurve, &AccelCurve::v>, py::arg("t"))
+      .def("x", &evaluateAny<AccelCurve, &AccelCurve::x>, py::arg("t"))
+      .def("sample", &sample<AccelCurve>, py::arg("Ts") = 1e-3f)
       .def("t_end", &AccelCurve::t_end)
       .def("v_end", &AccelCurve::v_end)
       .def("x_end", &AccelCurve::x_end)
@@ -55,10 +399,11 @@ PYBIND11_MODULE(ctrl, m) {
            py::arg("j_max"), py::arg("a_max"), py::arg("v_max"),
            py::arg("v_start"), py::arg("v_target"), py::arg("dist"),
            py::arg("x_start") = float(0), py::arg("t_start") = float(0))
-      .def("j", &AccelDesigner::j)
-      .def("a", &AccelDesigner::a)
-      .def("v", &AccelDesigner::v)
-      .def("x", &AccelDesigner::x)
+      .def("j", &evaluateAny<AccelDesigner, &AccelDesigner::j>, py::arg("t"))
+      .def("a", &evaluateAny<AccelDesigner, &AccelDesigner::a>, py::arg("t"))
+      .def("v", &evaluateAny<AccelDesigner, &AccelDesigner::v>, py::arg("t"))
+      .def("x", &evaluateAny<AccelDesigner, &AccelDesigner::x>, py::arg("t"))
+      .def("sample", &sample<AccelDesigner>, py::arg("Ts") = 1e-3f)
       .def("t_end", &AccelDesigner::t_end)
       .def("v_end", &AccelDesigner::v_end)
       .def("x_end", &AccelDesigner::x_end)
@@ -99,6 +444,29 @@ PYBIND11_MODULE(ctrl, m) {
       //
       ;
 
+  py::class_<Transform>(m, "Transform")
+      .def(py::init<>())
+      .def(py::init<Pose>())
+      .def_readonly("x", &Transform::x)
+      .def_readonly("y", &Transform::y)
+      .def_readonly("th", &Transform::th)
+      .def_readonly("c", &Transform::c)
+      .def_readonly("s", &Transform::s)
+      .def("toPose", &Transform::toPose)
+      .def("inverse", &Transform::inverse)
+      .def("apply", &Transform::apply)
+      .def("normalize", &Transform::normalize)
+      .def(py::self * py::self)
+      .def(py::self *= py::self)
+      .def("__str__",
+           [](const Transform &obj) {
+             std::stringstream ss;
+             ss << obj;
+             return ss.str();
+           })
+      //
+      ;
+
   py::class_<slalom::Shape>(m, "Shape")
       .def(py::init<Pose, float, float, float, float, float>(),
            py::arg("total"), py::arg("y_curve_end"), py::arg("x_adv") = 0,
@@ -145,4 +513,137 @@ PYBIND11_MODULE(ctrl, m) {
       .def("getAccelDesigner", &slalom::Trajectory::getAccelDesigner)
       //
       ;
+
+  py::class_<Polar>(m, "Polar")
+      .def(py::init<>())
+      .def(py::init<float, float>())
+      .def_readwrite("tra", &Polar::tra)
+      .def_readwrite("rot", &Polar::rot)
+      .def("clear", &Polar::clear)
+      .def(py::self += py::self)
+      .def(py::self -= py::self)
+      .def(py::self + py::self)
+      .def(py::self - py::self)
+      .def(py::self * py::self)
+      .def(py::self / py::self)
+      .def(py::self * float())
+      .def(py::self / float())
+      .def("__str__",
+           [](const Polar &obj) {
+             std::stringstream ss;
+             ss << obj;
+             return ss.str();
+           })
+      //
+      ;
+
+  py::class_<straight::Trajectory, AccelDesigner>(m, "StraightTrajectory")
+      .def(py::init<>())
+      .def("update", &straight::Trajectory::update, py::arg("state"),
+           py::arg("t"))
+      //
+      ;
+
+  py::class_<TrajectoryTracker> tt(m, "TrajectoryTracker");
+  py::class_<TrajectoryTracker::Gain>(tt, "Gain")
+      .def(py::init<>())
+      .def_readwrite("zeta", &TrajectoryTracker::Gain::zeta)
+      .def_readwrite("omega_n", &TrajectoryTracker::Gain::omega_n)
+      .def_readwrite("low_zeta", &TrajectoryTracker::Gain::low_zeta)
+      .def_readwrite("low_b", &TrajectoryTracker::Gain::low_b)
+      //
+      ;
+  py::class_<TrajectoryTracker::Result>(tt, "Result")
+      .def(py::init<>())
+      .def_readwrite("v", &TrajectoryTracker::Result::v)
+      .def_readwrite("w", &TrajectoryTracker::Result::w)
+      .def_readwrite("dv", &TrajectoryTracker::Result::dv)
+      .def_readwrite("dw", &TrajectoryTracker::Result::dw)
+      //
+      ;
+  tt.attr("Ts") = TrajectoryTracker::Ts;
+  tt.attr("xi_threshold") = TrajectoryTracker::xi_threshold;
+  tt.def(py::init<const TrajectoryTracker::Gain &>(),
+         py::arg("gain") = TrajectoryTracker::Gain())
+      .def("reset", &TrajectoryTracker::reset, py::arg("vs") = 0.0f)
+      .def("update",
+           py::overload_cast<const Pose &, const Polar &, const Polar &,
+                             const State &>(&TrajectoryTracker::update),
+           py::arg("est_q"), py::arg("est_v"), py::arg("est_a"),
+           py::arg("ref_s"))
+      .def("update",
+           py::overload_cast<const Pose &, const Polar &, const Polar &,
+                             const Pose &, const Pose &, const Pose &,
+                             const Pose &>(&TrajectoryTracker::update),
+           py::arg("est_q"), py::arg("est_v"), py::arg("est_a"),
+           py::arg("ref_q"), py::arg("ref_dq"), py::arg("ref_ddq"),
+           py::arg("ref_dddq"))
+      //
+      ;
+
+  using FC = FeedbackController<float>;
+  py::class_<FC> fc(m, "FeedbackController");
+  py::class_<FC::Model>(fc, "Model")
+      .def(py::init<>())
+      .def(py::init([](float K1, float T1) { return FC::Model{K1, T1}; }),
+           py::arg("K1"), py::arg("T1"))
+      .def_readwrite("K1", &FC::Model::K1)
+      .def_readwrite("T1", &FC::Model::T1)
+      //
+      ;
+  py::class_<FC::Gain>(fc, "Gain")
+      .def(py::init<>())
+      .def(py::init([](float Kp, float Ki, float Kd) {
+             return FC::Gain{Kp, Ki, Kd};
+           }),
+           py::arg("Kp"), py::arg("Ki"), py::arg("Kd"))
+      .def_readwrite("Kp", &FC::Gain::Kp)
+      .def_readwrite("Ki", &FC::Gain::Ki)
+      .def_readwrite("Kd", &FC::Gain::Kd)
+      //
+      ;
+  py::class_<FC::Breakdown>(fc, "Breakdown")
+      .def_readonly("ff", &FC::Breakdown::ff)
+      .def_readonly("fb", &FC::Breakdown::fb)
+      .def_readonly("fbp", &FC::Breakdown::fbp)
+      .def_readonly("fbi", &FC::Breakdown::fbi)
+      .def_readonly("fbd", &FC::Breakdown::fbd)
+      .def_readonly("u", &FC::Breakdown::u)
+      //
+      ;
+  fc.def(py::init<const FC::Model &, const FC::Gain &>(), py::arg("model"),
+         py::arg("gain"))
+      .def("reset", &FC::reset)
+      /* Ts の型はテンプレート引数なので明示する */
+      .def("update", &FC::update<float>, py::arg("r"), py::arg("y"),
+           py::arg("dr"), py::arg("dy"), py::arg("Ts"))
+      .def("updateFast", &FC::updateFast<float>, py::arg("r"), py::arg("y"),
+           py::arg("dr"), py::arg("dy"), py::arg("Ts"))
+      .def("getErrorIntegral", &FC::getErrorIntegral)
+      .def("getModel", &FC::getModel)
+      .def("setModel", &FC::setModel)
+      .def("getGain", &FC::getGain)
+      .def("setGain", &FC::setGain)
+      .def("getBreakdown", &FC::getBreakdown)
+      //
+      ;
+
+  bindAccumulator<8>(m);
+  bindAccumulator<16>(m);
+  bindAccumulator<32>(m);
+  bindAccumulator<64>(m);
+
+  m.def("simulate", &simulate, "run a closed-loop simulation in C++",
+        py::arg("segments"), py::arg("fc_tra"), py::arg("fc_rot"),
+        py::arg("plant_tra"), py::arg("plant_rot"),
+        py::arg("tracker_gain") = TrajectoryTracker::Gain());
+  m.def("design_accel", &designAccel,
+        "design AccelDesigners in parallel without the GIL",
+        py::arg("j_max"), py::arg("a_max"), py::arg("v_max"),
+        py::arg("v_start"), py::arg("v_target"), py::arg("dist"),
+        py::arg("threads") = 0);
+  m.def("design_shape", &designShape,
+        "design slalom Shapes in parallel without the GIL", py::arg("x"),
+        py::arg("y"), py::arg("th"), py::arg("y_curve_end"),
+        py::arg("x_adv") = 0.0f, py::arg("threads") = 0);
 }
@@ -23,10 +23,10 @@ def plot_accel_designer():
     time_stamps = ad.getTimeStamp()
     for i in range(len(time_stamps)-1):
         t = np.arange(time_stamps[i], time_stamps[i+1], 1e-3)
-        j = np.array([ad.j(tt) for tt in t])
-        a = np.array([ad.a(tt) for tt in t])
-        v = np.array([ad.v(tt) for tt in t])
-        x = np.array([ad.x(tt) for tt in t])
+        j = ad.j(t)
+        a = ad.a(t)
+        v = ad.v(t)
+        x = ad.x(t)
         for i, d in enumerate([j, a, v, x]):
             ax = axes[i]
             ax.plot(t, d, lw=4)
@@ -62,10 +62,10 @@ def plot_slalom():
     time_stamps.append(time_stamps[-1]+shape.straight_post / v)
     for i in range(len(time_stamps)-1):
         t = np.arange(time_stamps[i], time_stamps[i+1], Ts)
-        j = np.array([ad.j(tt) for tt in t])
-        a = np.array([ad.a(tt) for tt in t])
-        v = np.array([ad.v(tt) for tt in t])
-        x = np.array([ad.x(tt) for tt in t])
+        j = ad.j(t)
+        a = ad.a(t)
+        v = ad.v(t)
+        x = ad.x(t)
         for i, d in enumerate([j, a, v, x]):
             ax = axes[i]
             ax.plot(t, d, lw=4)
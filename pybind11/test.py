@@ -19,10 +19,10 @@ def plot_accel_designer(ad):
     dt = (time_stamps[-1] - time_stamps[0]) * 1e-4
     for i in range(len(time_stamps)-1):
         t = np.arange(time_stamps[i]+dt, time_stamps[i+1], dt)
-        j = np.array([ad.j(tt) for tt in t])
-        a = np.array([ad.a(tt) for tt in t])
-        v = np.array([ad.v(tt) for tt in t])
-        x = np.array([ad.x(tt) for tt in t])
+        j = ad.j(t)
+        a = ad.a(t)
+        v = ad.v(t)
+        x = ad.x(t)
         for i, d in enumerate([j, a, v, x]):
             ax = axes[i]
             ax.plot(t, d, lw=4)
@@ -73,7 +73,27 @@ def test_accel_designer():
         plot_accel_designer(ad)
 
 
+def test_evaluate_type():
+    # arrays always give arrays of the same shape, numbers give floats
+    ad = ctrl.AccelDesigner(100, 10, 4, 0, 2, 4)
+    for f in [ad.j, ad.a, ad.v, ad.x]:
+        for t in [np.array([0.1]), np.array(0.1), np.array([0.1], 'f4'),
+                  np.array(0.1, 'f4'), np.array([0.1, 0.2])]:
+            y = f(t)
+            assert isinstance(y, np.ndarray), (t, y)
+            assert y.shape == t.shape, (t, y)
+            assert math.isclose(float(y.flat[0]), f(0.1), rel_tol=1e-6)
+        for t in [0.1, 1, np.float32(0.1), np.float64(0.1)]:
+            assert isinstance(f(t), float), (t, f(t))
+        assert isinstance(f([0.1, 0.2]), np.ndarray)
+        # float64 is read directly and matches the float32 result
+        t = np.linspace(0, ad.t_end(), 101)
+        assert np.array_equal(f(t), f(t.astype('f4')))
+        assert np.array_equal(f(t[::2]), f(t[::2].astype('f4')))
+
+
 if __name__ == "__main__":
+    test_evaluate_type()
     # test_accel_curve()
     # test_accel_designer()
     plot_accel_designer(ctrl.AccelCurve(100, 6, 0, 1))
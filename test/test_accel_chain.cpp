@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accel_chain.h>
+
+#include <random>
+
+using namespace ctrl;
+
+TEST(AccelChain, JunctionVelocitiesAreFeasible) {
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> d_urd(10, 400);
+  std::uniform_real_distribution<float> v_urd(100, 3000);
+  const float j_max = 240000, a_max = 6000, v_max = 2400;
+  for (int n = 0; n < 100; ++n) {
+    std::vector<float> ds(20), limits(ds.size() + 1);
+    for (auto &d : ds)
+      d = d_urd(mt);
+    for (auto &v : limits)
+      v = v_urd(mt);
+    limits.front() = 0, limits.back() = 0;
+    AccelChain ac;
+    ac.reset(j_max, a_max, v_max, ds, limits, 0, 1);
+    const auto &vs = ac.getVelocities();
+    const auto &segs = ac.getSegments();
+    ASSERT_EQ(segs.size(), ds.size());
+    float x = 0;
+    for (std::size_t i = 0; i < segs.size(); ++i) {
+      /* 上限を守り，計画どおりの終点速度に到達する */
+      EXPECT_LE(vs[i + 1], std::min(limits[i + 1], v_max));
+      EXPECT_NEAR(segs[i].v_end(), vs[i + 1], 1e-3f * vs[i + 1] + 1e-2f);
+      x += ds[i];
+      EXPECT_NEAR(segs[i].x_end(), x, 1e-3f * x);
+      if (i) {
+        EXPECT_FLOAT_EQ(segs[i].t_0(), segs[i - 1].t_end());
+      }
+    }
+    EXPECT_NEAR(ac.x(ac.t_end()), x, 1e-3f * x);
+    EXPECT_NEAR(ac.v(ac.t_end()), 0, 1e-2f);
+  }
+}
+
+TEST(AccelChain, ShortSegmentLimitsUpstream) {
+  /* 短い区間の後の低速な接続点のために，手前で減速しておく */
+  std::vector<float> vs = {0, 2000, 300, 0};
+  const std::vector<float> ds = {1000, 20, 500};
+  AccelChain::planVelocities(240000, 6000, ds.data(), vs.data(), ds.size());
+  EXPECT_LT(vs[1], 2000);
+  EXPECT_FLOAT_EQ(vs[2], 300);
+  EXPECT_NEAR(AccelCurve::calcDistanceFromVelocityStartToEnd(240000, 6000,
+                                                             vs[2], vs[1]),
+              ds[1], 1e-2f * ds[1]);
+}
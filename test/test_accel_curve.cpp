@@ -43,6 +43,12 @@ public:
       EXPECT_LE(std::abs(a(t + Ts / 2) - a(t - Ts / 2)) / Ts, jm * (2 + e));
       EXPECT_LE(std::abs(v(t + Ts / 2) - v(t - Ts / 2)) / Ts, am * (2 + e));
     }
+    /* t(x) is the inverse of x(t) */
+    const float ex = 1e-4f * (std::abs(x_end()) + 1);
+    for (int i = 0; i < 1000; ++i) {
+      const auto xt = x(t0 + (t3 - t0) * i / 1000);
+      EXPECT_NEAR(x(AccelCurve::t(xt)), xt, ex);
+    }
   }
 };
 
@@ -27,6 +27,12 @@ public:
     EXPECT_NEAR(d, x3 - x0, std::abs(d) * e);
     EXPECT_NEAR(x(t0), xs, std::abs(xs) * e * 1e3f);
     EXPECT_NEAR(x(t3), xs + d, std::abs(xs + d) * e * 1e3f);
+    /* t(x) is the inverse of x(t) */
+    const float ex = 1e-4f * (std::abs(xs) + std::abs(d) + 1);
+    for (int i = 0; i < 1000; ++i) {
+      const auto xt = x(t0 + (t3 - t0) * i / 1000);
+      EXPECT_NEAR(x(AccelDesigner::t(xt)), xt, ex);
+    }
   }
 };
 
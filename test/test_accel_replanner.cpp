@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accel_replanner.h>
+
+#include <random>
+
+using namespace ctrl;
+
+namespace {
+/* 現在時刻での連続性と，続きの軌道の制限を確認する */
+template <typename A>
+void expectContinuation(const A &running, const AccelReplanner &ar,
+                        const float t, const float j_max, const float a_max) {
+  EXPECT_NEAR(ar.x(t), running.x(t), 1e-3f);
+  EXPECT_NEAR(ar.v(t), running.v(t), 1e-2f);
+  EXPECT_NEAR(ar.a(t), running.a(t), 1e-3f * a_max);
+  const float dt = (ar.t_end() - t) / 1000;
+  float v_prev = ar.v(t), a_prev = ar.a(t);
+  for (float tt = t + dt; tt < ar.t_end(); tt += dt) {
+    EXPECT_LE(std::abs(ar.j(tt)), j_max * (1 + 1e-4f));
+    EXPECT_LE(std::abs(ar.a(tt)), a_max * (1 + 1e-3f));
+    /* 加速度と速度が跳ばない */
+    EXPECT_NEAR(ar.a(tt), a_prev, j_max * dt * 1.01f + 1e-3f * a_max);
+    EXPECT_NEAR(ar.v(tt), v_prev, a_max * dt * 1.01f + 1e-2f);
+    v_prev = ar.v(tt), a_prev = ar.a(tt);
+  }
+}
+} // namespace
+
+TEST(AccelReplanner, ContinueAcceleration) {
+  const float jm = 240000, am = 3600, vm = 1200;
+  const AccelDesigner ad(jm, am, vm, 0, 1200, 900);
+  const float t = ad.t_1() / 2 + ad.t_0() / 2; //< 等加速度の途中
+  ASSERT_GT(ad.a(t), am / 2);
+  AccelReplanner ar;
+  ar.replan(jm, am, vm, ad, t, 900, 600);
+  EXPECT_FALSE(ar.hasRamp());
+  expectContinuation(ad, ar, t, jm, am);
+  EXPECT_NEAR(ar.v_end(), 900, 1e-2f);
+  EXPECT_NEAR(ar.x_end(), ad.x(t) + 600, 1e-3f);
+}
+
+TEST(AccelReplanner, RampDownBeforeStop) {
+  /* 加速中に停止距離が足りなくなり，加速度を先に0に戻す */
+  const float jm = 240000, am = 3600, vm = 1200;
+  AccelReplanner ar;
+  ar.reset(jm, am, vm, 1000, 3600, 0, 150, 10, 1);
+  EXPECT_TRUE(ar.hasRamp());
+  EXPECT_FLOAT_EQ(ar.x(1), 10);
+  EXPECT_FLOAT_EQ(ar.v(1), 1000);
+  EXPECT_FLOAT_EQ(ar.a(1), 3600);
+  EXPECT_FLOAT_EQ(ar.j(1), -jm);
+  EXPECT_NEAR(ar.x_end(), 160, 1e-3f);
+  EXPECT_LT(ar.v_end(), 1000);
+  /* 続けて再計画しても連続 */
+  const float t = 1 + 0.01f;
+  AccelReplanner ar2;
+  ar2.replan(jm, am, vm, ar, t, 0, 400);
+  expectContinuation(ar, ar2, t, jm, am);
+  EXPECT_NEAR(ar2.v_end(), 0, 1e-2f);
+}
+
+TEST(AccelReplanner, RandomStates) {
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> v_urd(0, 2000);
+  std::uniform_real_distribution<float> d_urd(100, 2000);
+  std::uniform_real_distribution<float> r_urd(0, 1);
+  const float jm = 240000, am = 6000, vm = 2400;
+  for (int i = 0; i < 200; ++i) {
+    const AccelDesigner ad(jm, am, vm, v_urd(mt), v_urd(mt), d_urd(mt));
+    const float t = ad.t_end() * r_urd(mt);
+    AccelReplanner ar;
+    ar.replan(jm, am, vm, ad, t, v_urd(mt), d_urd(mt));
+    expectContinuation(ad, ar, t, jm, am);
+  }
+}
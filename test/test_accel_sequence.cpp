@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accel_sequence.h>
+
+#include <random>
+
+using namespace ctrl;
+
+TEST(AccelDesigner, PackUnpack) {
+  static_assert(sizeof(AccelDesigner::Packed) == 32, "unexpected size");
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> j_urd(100000, 1000000);
+  std::uniform_real_distribution<float> a_urd(100, 10000);
+  std::uniform_real_distribution<float> v_urd(10, 10000);
+  std::uniform_real_distribution<float> x_urd(1, 10000);
+  std::uniform_real_distribution<float> t_urd(-100, 100);
+  for (int i = 0; i < 1000; ++i) {
+    const auto jm = j_urd(mt), am = a_urd(mt), vm = v_urd(mt);
+    const auto vs = v_urd(mt), vt = v_urd(mt), d = x_urd(mt);
+    const AccelDesigner ad(jm, am, vm, vs, vt, d, x_urd(mt), t_urd(mt));
+    AccelDesigner ud;
+    ud.unpack(ad.pack());
+    const auto ts = ad.getTimeStamp(), us = ud.getTimeStamp();
+    for (std::size_t k = 0; k < ts.size(); ++k)
+      EXPECT_NEAR(us[k], ts[k], 1e-6f * std::abs(ts[k]) + 1e-6f);
+    EXPECT_FLOAT_EQ(ud.x_end(), ad.x_end());
+    EXPECT_FLOAT_EQ(ud.v_end(), ad.v_end());
+    const auto t = (ad.t_0() + ad.t_end()) / 2;
+    EXPECT_NEAR(ud.x(t), ad.x(t), 1e-5f * std::abs(ad.x(t)) + 1e-3f);
+    EXPECT_NEAR(ud.v(t), ad.v(t), 1e-5f * std::abs(ad.v(t)) + 1e-3f);
+  }
+  AccelDesigner empty;
+  empty.unpack(AccelDesigner().pack());
+  EXPECT_EQ(empty.t_end(), 0);
+}
+
+TEST(AccelSequence, Evaluate) {
+  AccelSequence<4> seq;
+  EXPECT_EQ(seq.size(), 0u);
+  AccelDesigner ads[5];
+  float v = 0, x = 0, t = 0;
+  const float vts[5] = {600, 1200, 300, 900, 0};
+  for (int i = 0; i < 5; ++i) {
+    ads[i].reset(240000, 3600, 1200, v, vts[i], 90 * float(i + 1), x, t);
+    v = ads[i].v_end(), x = ads[i].x_end(), t = ads[i].t_end();
+    EXPECT_EQ(seq.push(ads[i]), i < 4);
+  }
+  EXPECT_EQ(seq.size(), 4u);
+  for (std::size_t i = 0; i < seq.size(); ++i)
+    EXPECT_NEAR(seq[i].t_end(), ads[i].t_end(), 1e-6f);
+  for (float tt = 0; tt < ads[3].t_end(); tt += 1e-3f) {
+    std::size_t i = 0;
+    while (i < 3 && ads[i + 1].t_0() <= tt)
+      ++i;
+    EXPECT_EQ(seq.index(tt), i);
+    EXPECT_NEAR(seq.x(tt), ads[i].x(tt), 1e-3f);
+    EXPECT_NEAR(seq.v(tt), ads[i].v(tt), 1e-2f);
+    EXPECT_NEAR(seq.a(tt), ads[i].a(tt), 1e-1f);
+  }
+  seq.clear();
+  EXPECT_EQ(seq.size(), 0u);
+}
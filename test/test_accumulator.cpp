@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accumulator.h>
+#include <ctrl/polar.h>
+#include <ctrl/shared_accumulator.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace ctrl;
+
+TEST(Accumulator, PushAndIndex) {
+  Accumulator<int, 4> acc(1);
+  EXPECT_EQ(acc.size(), 4u);
+  EXPECT_EQ(acc.average(), 1);
+  for (int i = 0; i < 10; ++i)
+    acc.push(i);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(acc[i], 9 - i);
+  EXPECT_EQ(acc.average(2), 8);
+}
+
+TEST(RunningAccumulator, AgreesWithScan) {
+  constexpr std::size_t S = 20;
+  RunningAccumulator<float, S, 7> acc(1.0f);
+  std::mt19937 mt{1};
+  std::normal_distribution<float> nd(100, 3);
+  for (int k = 0; k < 1000; ++k) {
+    acc.push(nd(mt));
+    for (std::size_t n = 1; n <= S; ++n) {
+      float sum = 0, sq = 0;
+      for (std::size_t i = 0; i < n; ++i)
+        sum += acc[i], sq += acc[i] * acc[i];
+      const float mean = sum / n;
+      EXPECT_NEAR(acc.average(n), mean, 1e-3f);
+      EXPECT_NEAR(acc.variance(n), sq / n - mean * mean, 1e-1f);
+    }
+  }
+  acc.clear(2.0f);
+  EXPECT_FLOAT_EQ(acc.average(), 2.0f);
+  EXPECT_NEAR(acc.variance(), 0.0f, 1e-6f);
+}
+
+TEST(RunningAccumulator, Polar) {
+  RunningAccumulator<Polar, 4> acc;
+  acc.push(Polar(1, 2));
+  acc.push(Polar(3, 6));
+  EXPECT_FLOAT_EQ(acc.average(2).tra, 2);
+  EXPECT_FLOAT_EQ(acc.average(2).rot, 4);
+  EXPECT_FLOAT_EQ(acc.variance(2).tra, 1);
+  EXPECT_FLOAT_EQ(acc.variance(2).rot, 4);
+  EXPECT_FLOAT_EQ(acc.average().tra, 1);
+}
+
+TEST(Accumulator, Copy) {
+  static_assert(std::is_trivially_copyable<Accumulator<float, 8>>::value,
+                "Accumulator should be trivially copyable");
+  Accumulator<float, 8> acc;
+  for (int i = 0; i < 11; ++i)
+    acc.push(i);
+  const auto copy = acc;
+  acc.push(100);
+  for (int i = 0; i < 8; ++i)
+    EXPECT_EQ(copy[i], 10 - i);
+  EXPECT_EQ(acc[0], 100);
+}
+
+TEST(SharedAccumulator, ProducerAndReaders) {
+  constexpr std::size_t S = 16;
+  constexpr int N = 100000;
+  SharedAccumulator<int, S> acc(0);
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+  std::atomic<int> reads{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        /* the producer pushes 1, 2, 3, ... so a snapshot is consecutive */
+        const auto s = acc.snapshot();
+        for (std::size_t i = 1; i < S; ++i)
+          if (s[i - 1] > int(S) && s[i] != s[i - 1] - 1)
+            errors++;
+        const auto latest = acc[0];
+        const auto average = acc.average(4);
+        if (latest > 4 && average < latest - 8)
+          errors++;
+        reads++;
+        std::this_thread::yield(); //< let the producer run on a single core
+      }
+    });
+  }
+  std::thread producer([&] {
+    for (int i = 1; i <= N; ++i)
+      acc.push(i);
+    done = true;
+  });
+  producer.join();
+  for (auto &r : readers)
+    r.join();
+  EXPECT_EQ(errors.load(), 0);
+  EXPECT_GT(reads.load(), 0);
+  EXPECT_EQ(acc[0], N);
+  EXPECT_EQ(acc.average(2), N - 1); //< (N + N - 1) / 2 with int
+}
+
+template <std::size_t S> void testOrderStatistics(const int seed) {
+  MinMaxAccumulator<int, S> mm(5);
+  MedianAccumulator<int, S> md(5);
+  EXPECT_EQ(mm.min(), 5);
+  EXPECT_EQ(mm.max(), 5);
+  EXPECT_EQ(md.median(), 5);
+  std::mt19937 mt(seed);
+  std::uniform_int_distribution<int> uid(-50, 50);
+  for (int k = 0; k < 2000; ++k) {
+    /* monotone runs exercise the deques, repeats exercise ties */
+    const int value = k % 300 < 100 ? k : k % 300 < 200 ? -k : uid(mt);
+    mm.push(value);
+    md.push(value);
+    std::array<int, S> sorted;
+    for (std::size_t i = 0; i < S; ++i)
+      sorted[i] = mm[i];
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(mm.min(), sorted.front());
+    EXPECT_EQ(mm.max(), sorted.back());
+    EXPECT_EQ(md.median(), sorted[(S - 1) / 2]);
+  }
+  mm.clear(3);
+  md.clear(3);
+  EXPECT_EQ(mm.max(), 3);
+  EXPECT_EQ(md.median(), 3);
+}
+
+TEST(MinMaxMedianAccumulator, AgreesWithSort) {
+  testOrderStatistics<1>(1);
+  testOrderStatistics<2>(2);
+  testOrderStatistics<7>(3);
+  testOrderStatistics<16>(4);
+}
+
+TEST(Accumulator, BulkPush) {
+  Accumulator<int, 8> bulk;
+  Accumulator<int, 8> single;
+  std::vector<int> data(20);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = i;
+  /* block sizes across the wrap point and larger than the buffer */
+  int offset = 0;
+  for (const std::size_t n : {3, 5, 7, 1, 0, 12, 20}) {
+    for (std::size_t i = 0; i < n; ++i)
+      data[i] = offset++;
+    bulk.push(data.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+      single.push(data[i]);
+    for (std::size_t i = 0; i < 8; ++i)
+      EXPECT_EQ(bulk[i], single[i]);
+  }
+}
+
+TEST(DecimationCascade, Average) {
+  DecimationCascade<float, 4, 10, 3> dc;
+  std::vector<float> data(1000);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = i;
+  dc.push(data.data(), data.size());
+  EXPECT_FLOAT_EQ(dc.level(0)[0], 999);
+  EXPECT_FLOAT_EQ(dc.level(0)[3], 996);
+  /* mean of 990..999, 980..989, ... */
+  EXPECT_FLOAT_EQ(dc.level(1)[0], 994.5f);
+  EXPECT_FLOAT_EQ(dc.level(1)[1], 984.5f);
+  /* mean of 900..999, 800..899, ... */
+  EXPECT_FLOAT_EQ(dc.level(2)[0], 949.5f);
+  EXPECT_FLOAT_EQ(dc.level(2)[3], 649.5f);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/binary_log.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace ctrl;
+
+TEST(BinaryLog, WriteRead) {
+  const char *path = "test_binary_log.bin";
+  const uint64_t n = 10007; //< not a multiple of the buffer
+  {
+    std::ofstream of(path, std::ios::binary);
+    BinaryLogWriter w(of, {"t", "v", "a_very_long_column_name"}, 64);
+    for (uint64_t i = 0; i < n; ++i)
+      EXPECT_TRUE(w.push({i * 1e-3f, float(i), -float(i)}));
+    EXPECT_FALSE(w.push({1, 2}));       //< rejected: too few columns
+    EXPECT_FALSE(w.push({1, 2, 3, 4})); //< rejected: too many columns
+    EXPECT_EQ(w.size(), n);
+  }
+  BinaryLogReader r(path);
+  ASSERT_TRUE(r.isOpen());
+  EXPECT_EQ(r.columns(), 3u);
+  EXPECT_EQ(r.rows(), n);
+  EXPECT_EQ(r.name(0), "t");
+  EXPECT_EQ(r.name(2), "a_very_long_col");
+  EXPECT_EQ(r.find("v"), 1);
+  EXPECT_EQ(r.find("x"), -1);
+  for (uint64_t i = 0; i < n; ++i) {
+    EXPECT_EQ(r(i, 0), i * 1e-3f);
+    EXPECT_EQ(r.row(i)[1], float(i));
+    EXPECT_EQ(r(i, 2), -float(i));
+  }
+  r.close();
+  std::remove(path);
+}
+
+TEST(BinaryLog, Truncated) {
+  const char *path = "test_binary_log_truncated.bin";
+  {
+    std::ofstream of(path, std::ios::binary);
+    BinaryLogWriter w(of, {"x", "y"});
+    for (int i = 0; i < 100; ++i)
+      w.push({float(i), float(i)});
+    w.flush();
+    of.write("\0\0\0", 3); //< half a row after an interrupted write
+    of.flush();
+    /* header has not been closed yet */
+    BinaryLogReader r(path);
+    ASSERT_TRUE(r.isOpen());
+    EXPECT_EQ(r.rows(), 100u);
+  }
+  BinaryLogReader r(path);
+  ASSERT_TRUE(r.isOpen());
+  EXPECT_EQ(r.rows(), 100u);
+  std::remove(path);
+  EXPECT_FALSE(BinaryLogReader("no_such_file.bin").isOpen());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accel_designer.h>
+#include <ctrl/csv_writer.h>
+
+#include <sstream>
+
+using namespace ctrl;
+
+TEST(CsvWriter, MatchesOstream) {
+  const float values[] = {0, 1, -2.5f, 0.1f, 1e-7f, 123456789.f, 3.14159265f};
+  std::stringstream expected, actual;
+  {
+    CsvWriter csv(actual, 64); //< small buffer to exercise spilling
+    for (int r = 0; r < 100; ++r) {
+      for (int c = 0; c < 7; ++c) {
+        const float v = values[c] * float(r + 1);
+        expected << (c ? "," : "") << v;
+        csv.field(v);
+      }
+      expected << "\n";
+      csv.endRow();
+    }
+  }
+  EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST(CsvWriter, Header) {
+  std::stringstream ss;
+  {
+    CsvWriter csv(ss);
+    csv.field("t"), csv.field("v"), csv.endRow();
+    csv.row({0.5f, 2});
+    EXPECT_EQ(ss.str(), "");
+    csv.flush();
+    EXPECT_EQ(ss.str(), "t,v\n0.5,2\n");
+  }
+}
+
+TEST(CsvWriter, PrintCsv) {
+  const AccelDesigner ad(240000, 3600, 1200, 0, 0, 90);
+  std::stringstream expected, actual;
+  ad.printCsv(expected);
+  {
+    CsvWriter csv(actual);
+    ad.printCsv(csv);
+    ad.printCsv(csv); //< reuse the same buffer
+  }
+  EXPECT_FALSE(expected.str().empty());
+  EXPECT_EQ(actual.str(), expected.str() + expected.str());
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/feedback_controller.h>
+#include <ctrl/lanes.h>
+
+#include <random>
+
+using namespace ctrl;
+
+TEST(FeedbackController, LanesAgreeWithScalar) {
+  constexpr std::size_t N = 4;
+  using L = Lanes<float, N>;
+  const float Ts = 1e-3f;
+  const L K1(1.0f, 2.0f, 0.5f, 1.5f), T1(0.1f, 0.2f, 0.0f, 0.05f);
+  const L Kp(1.0f, 0.5f, 0.0f, 2.0f), Ki(10.0f, 0.0f, 5.0f, 1.0f),
+      Kd(0.01f, 0.02f, 0.0f, 0.1f);
+  FeedbackController<L> bank({K1, T1}, {Kp, Ki, Kd});
+  std::vector<FeedbackController<float>> scalars;
+  for (std::size_t i = 0; i < N; ++i)
+    scalars.push_back({{K1[i], T1[i]}, {Kp[i], Ki[i], Kd[i]}});
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> urd(-1, 1);
+  for (int k = 0; k < 1000; ++k) {
+    L r, y, dr, dy;
+    for (std::size_t i = 0; i < N; ++i)
+      r[i] = urd(mt), y[i] = urd(mt), dr[i] = urd(mt), dy[i] = urd(mt);
+    const auto u = bank.update(r, y, dr, dy, Ts);
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto ui = scalars[i].update(r[i], y[i], dr[i], dy[i], Ts);
+      EXPECT_FLOAT_EQ(u[i], ui);
+      /* breakdown per lane */
+      EXPECT_FLOAT_EQ(bank.getBreakdown().ff[i], scalars[i].getBreakdown().ff);
+      EXPECT_FLOAT_EQ(bank.getBreakdown().fbi[i],
+                      scalars[i].getBreakdown().fbi);
+    }
+  }
+  bank.reset();
+  EXPECT_FLOAT_EQ(bank.getErrorIntegral()[0], 0);
+}
+
+TEST(Lanes, Arithmetic) {
+  using L = Lanes<float, 3>;
+  const L a(1, 2, 3);
+  const L b(2.0f);
+  EXPECT_FLOAT_EQ((a + b)[2], 5);
+  EXPECT_FLOAT_EQ((a - b)[0], -1);
+  EXPECT_FLOAT_EQ((a * b)[1], 4);
+  EXPECT_FLOAT_EQ((a / b)[2], 1.5f);
+  EXPECT_FLOAT_EQ((a * 3.0f)[1], 6);
+  EXPECT_FLOAT_EQ((-a)[0], -1);
+  EXPECT_EQ(L::size(), 3u);
+}
+
+TEST(FeedbackController, UpdateFast) {
+  const FeedbackController<float>::Model model = {1.2f, 0.03f};
+  const FeedbackController<float>::Gain gain = {0.1f, 10.0f, 0.001f};
+  FeedbackController<float> fc(model, gain);
+  FeedbackController<float> fast(model, gain);
+  std::mt19937 mt{2};
+  std::uniform_real_distribution<float> urd(-3, 3);
+  for (int k = 0; k < 1000; ++k) {
+    const auto r = urd(mt), y = urd(mt), dr = urd(mt), dy = urd(mt);
+    const auto u = fc.update(r, y, dr, dy, 1e-3f);
+    EXPECT_FLOAT_EQ(fast.updateFast(r, y, dr, dy, 1e-3f), u);
+    EXPECT_NEAR(fc.getBreakdown().ff, (model.T1 * dr + r) / model.K1, 1e-6f);
+  }
+  EXPECT_FLOAT_EQ(fast.getErrorIntegral(), fc.getErrorIntegral());
+  /* cached coefficients follow the model */
+  fc.setModel({2.0f, 0.0f});
+  fc.update(1, 1, 0, 0, 1e-3f);
+  EXPECT_FLOAT_EQ(fc.getBreakdown().ff, 0.5f);
+}
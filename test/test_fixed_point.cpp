@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/feedback_controller.h>
+#include <ctrl/fixed_point.h>
+#include <ctrl/straight.h>
+#include <ctrl/trajectory_tracker_fixed.h>
+
+#include <cmath>
+
+using namespace ctrl;
+
+TEST(Fixed, Arithmetic) {
+  const Q16 a = 1.5f, b = -2.25f;
+  EXPECT_EQ(Q16(1.0f).getRaw(), 1 << 16);
+  EXPECT_FLOAT_EQ((a + b).toFloat(), -0.75f);
+  EXPECT_FLOAT_EQ((a - b).toFloat(), 3.75f);
+  EXPECT_FLOAT_EQ((a * b).toFloat(), -3.375f);
+  EXPECT_FLOAT_EQ((b / a).toFloat(), -1.5f);
+  EXPECT_FLOAT_EQ((-a).toFloat(), -1.5f);
+  EXPECT_TRUE(b < a);
+  EXPECT_FLOAT_EQ(abs(b).toFloat(), 2.25f);
+}
+
+TEST(Fixed, Saturation) {
+  const Q16 big = 30000.0f;
+  EXPECT_EQ(big + big, Q16::max());
+  EXPECT_EQ(-big - big, Q16::min());
+  EXPECT_EQ(big * big, Q16::max());
+  EXPECT_EQ(big * -big, Q16::min());
+  EXPECT_EQ(big / Q16(1e-3f), Q16::max());
+  EXPECT_EQ(big / Q16(), Q16::max());
+  EXPECT_EQ(-big / Q16(), Q16::min());
+  EXPECT_EQ(Q16(1e6f), Q16::max());
+  EXPECT_EQ(Q16(-1e6f), Q16::min());
+  EXPECT_EQ(-Q16::min(), Q16::max());
+}
+
+TEST(Fixed, Math) {
+  for (float x = -20; x < 20; x += 1e-3f) {
+    const Q16 f = x;
+    EXPECT_NEAR(sin(f).toFloat(), std::sin(f.toFloat()), 2e-5f);
+    EXPECT_NEAR(cos(f).toFloat(), std::cos(f.toFloat()), 2e-5f);
+  }
+  for (float x = 0; x < 30000; x += 0.7f) {
+    const Q16 f = x;
+    EXPECT_NEAR(sqrt(f).toFloat(), std::sqrt(f.toFloat()), 2e-5f);
+  }
+  EXPECT_EQ(sqrt(Q16(-1.0f)), Q16());
+}
+
+TEST(Fixed, FeedbackController) {
+  const float Ts = 1e-3f;
+  FeedbackController<float> ff({1.2f, 0.03f}, {2.0f, 10.0f, 0.01f});
+  FeedbackController<Q16> fx({1.2f, 0.03f}, {2.0f, 10.0f, 0.01f});
+  FeedbackController<Q16> fq({1.2f, 0.03f}, {2.0f, 10.0f, 0.01f});
+  const Q16 Ts_q = Ts; //< converted once
+  /* [mm/s] so that the integrand e * Ts is well above the resolution */
+  const AccelDesigner ad(240000, 9000, 1200, 0, 0, 720);
+  for (int i = 0; i * Ts < ad.t_end(); ++i) {
+    const float t = i * Ts;
+    const auto r = ad.v(t), y = 0.9f * r, dr = ad.a(t), dy = dr;
+    const auto u = ff.update(r, y, dr, dy, Ts);
+    /* Ts is rounded to 66 / 65536 in Q15.16, so allow 1% */
+    const auto tol = 1e-2f * std::abs(u) + 0.1f;
+    const auto ux = fx.update(r, y, dr, dy, Ts);
+    EXPECT_NEAR(ux.toFloat(), u, tol);
+    EXPECT_EQ(fq.update(r, y, dr, dy, Ts_q), ux);
+  }
+}
+
+TEST(Fixed, TrajectoryTracker) {
+  const float Ts = TrajectoryTracker::Ts;
+  const TrajectoryTracker::Gain gain;
+  TrajectoryTracker tt(gain);
+  TrajectoryTrackerFixed<16> tf(gain);
+  straight::Trajectory st;
+  st.reset(240000, 6000, 1200, 0, 600, 360);
+  tt.reset(), tf.reset();
+  State s;
+  for (int i = 0; i * Ts < st.t_end(); ++i) {
+    st.update(s, i * Ts);
+    /* pose error to exercise the feedback */
+    const auto est_q = s.q + Pose(1, -1, 0.01f);
+    const auto est_v = Polar(s.dq.x, 0);
+    const auto est_a = Polar(s.ddq.x, 0);
+    const auto a = tt.update(est_q, est_v, est_a, s);
+    const auto b = tf.update(est_q, est_v, est_a, s);
+    EXPECT_NEAR(b.v, a.v, 1e-3f * std::abs(a.v) + 1);
+    EXPECT_NEAR(b.w, a.w, 1e-2f * std::abs(a.w) + 1e-2f);
+    EXPECT_NEAR(b.dv, a.dv, 1e-3f * std::abs(a.dv) + 3);
+    EXPECT_NEAR(b.dw, a.dw, 2e-2f * std::abs(a.dw) + 0.5f);
+  }
+}
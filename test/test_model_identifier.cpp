@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/model_identifier.h>
+
+#include <cmath>
+#include <random>
+
+using namespace ctrl;
+
+TEST(ModelIdentifier, FirstOrderPlant) {
+  const float Ts = 1e-3f, K1 = 5.8f, T1 = 0.36f;
+  const float a = std::exp(-Ts / T1);
+  ModelIdentifier mi;
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> urd(-1, 1);
+  float y = 0, u = 0;
+  for (int k = 0; k < 100000; ++k) {
+    if (k % 200 == 0)
+      u = urd(mt); //< piecewise constant excitation
+    mi.push(u, y);
+    y = a * y + K1 * (1 - a) * u;
+  }
+  EXPECT_EQ(mi.size(), 100000u);
+  FeedbackController<float>::Model model;
+  ASSERT_TRUE(mi.estimate(model, Ts));
+  EXPECT_NEAR(model.K1, K1, 1e-2f);
+  EXPECT_NEAR(model.T1, T1, 1e-3f);
+}
+
+TEST(ModelIdentifier, NotExcited) {
+  ModelIdentifier mi;
+  FeedbackController<float>::Model model;
+  EXPECT_FALSE(mi.estimate(model, 1e-3f));
+  for (int k = 0; k < 1000; ++k)
+    mi.push(0, 0);
+  EXPECT_FALSE(mi.estimate(model, 1e-3f));
+  mi.reset();
+  EXPECT_EQ(mi.size(), 0u);
+}
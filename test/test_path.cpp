@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/path.h>
+
+using namespace ctrl;
+
+namespace {
+const slalom::Shape F90(Pose(90, 90, M_PI / 2), 70);
+const slalom::Shape F45(Pose(90, 45, M_PI / 4), 30);
+} // namespace
+
+TEST(Path, StraightOnly) {
+  path::Trajectory tr;
+  EXPECT_TRUE(tr.reset(
+      {path::Motion::straight(90), path::Motion::straight(180)}, 240000, 3600,
+      1200));
+  const AccelDesigner ad(240000, 3600, 1200, 0, 0, 270);
+  EXPECT_EQ(tr.getSegments().size(), 1u);
+  EXPECT_FLOAT_EQ(tr.t_end(), ad.t_end());
+  for (float t = 0; t < ad.t_end(); t += 1e-2f) {
+    const auto s = tr.stateAt(t);
+    EXPECT_FLOAT_EQ(s.q.x, ad.x(t));
+    EXPECT_FLOAT_EQ(s.dq.x, ad.v(t));
+    EXPECT_EQ(s.q.y, 0);
+  }
+}
+
+TEST(Path, TurnsAreContinuous) {
+  path::Trajectory tr;
+  EXPECT_TRUE(tr.reset({path::Motion::straight(90), path::Motion::turn(F90),
+                        path::Motion::turn(F90, true),
+                        path::Motion::straight(180),
+                        path::Motion::turn(F45, false, 300)},
+                       240000, 3600, 1200, 0, 0, Pose(0, 0, 0), 1));
+  EXPECT_FLOAT_EQ(tr.t_start(), 1);
+  /* 終点: 直線 90, 左 90 度, 右 90 度, 直線 180, 左 45 度 */
+  const auto &end = tr.getPoseEnd();
+  EXPECT_NEAR(end.x, 90 + 90 + 90 + 180 + 90, 0.5f);
+  EXPECT_NEAR(end.y, 90 + 90 + 45, 0.5f);
+  EXPECT_NEAR(end.th, M_PI / 4, 1e-5f);
+  const auto last = tr.stateAt(tr.t_end() + 1);
+  EXPECT_NEAR(last.q.x, end.x, 1e-3f);
+  EXPECT_NEAR(last.q.y, end.y, 1e-3f);
+  /* 区間の境界で状態が連続 */
+  const auto &segs = tr.getSegments();
+  for (std::size_t i = 1; i < segs.size(); ++i) {
+    const float tb = segs[i].ad.t_0(), e = 1e-5f;
+    const auto a = tr.stateAt(tb - e), b = tr.stateAt(tb + e);
+    EXPECT_NEAR(a.q.x, b.q.x, 1e-2f) << i;
+    EXPECT_NEAR(a.q.y, b.q.y, 1e-2f) << i;
+    EXPECT_NEAR(a.q.th, b.q.th, 1e-3f) << i;
+    EXPECT_NEAR(a.dq.x, b.dq.x, 0.5f) << i;
+    EXPECT_NEAR(a.dq.y, b.dq.y, 0.5f) << i;
+  }
+  /* ターンの補間は直接の積分と一致 */
+  const auto &seg = segs[1];
+  ASSERT_TRUE(seg.turn);
+  EXPECT_FLOAT_EQ(seg.v, F90.v_ref);
+  slalom::Trajectory st(F90);
+  st.reset(seg.v, seg.th0, seg.ad.t_0());
+  State s;
+  s.q = Pose(seg.x0, seg.y0, seg.th0);
+  const float Ts = 1e-3f;
+  for (float t = seg.ad.t_0(); t + Ts < seg.ad.t_end(); t += Ts) {
+    st.update(s, t, Ts);
+    const auto r = tr.stateAt(t + Ts);
+    EXPECT_NEAR(r.q.x, s.q.x, 1e-2f);
+    EXPECT_NEAR(r.q.y, s.q.y, 1e-2f);
+    EXPECT_NEAR(r.dq.x, s.dq.x, 1e-2f);
+    EXPECT_NEAR(r.ddq.y, s.ddq.y, 1e-1f);
+  }
+}
+
+TEST(Path, TurnVelocityIsPlannedAhead) {
+  /* 長い直線の後の低速なターン，短い間隔で続くターン */
+  path::Trajectory tr;
+  EXPECT_TRUE(tr.reset(
+      {path::Motion::straight(720), path::Motion::turn(F90, false, 300),
+       path::Motion::turn(F90, true, 1200), path::Motion::straight(10),
+       path::Motion::turn(F45, false, 600), path::Motion::straight(45)},
+      240000, 3600, 2400));
+  const float caps[] = {300, 1200, 600};
+  int k = 0;
+  float v = 0;
+  for (const auto &seg : tr.getSegments()) {
+    if (!seg.turn) {
+      v = seg.ad.v_end();
+      continue;
+    }
+    ASSERT_LT(k, 3);
+    /* 直線の終点速度でターンに入り，上限を超えない */
+    EXPECT_FLOAT_EQ(seg.v, v);
+    EXPECT_LE(seg.v, caps[k++] + 0.5f);
+  }
+  EXPECT_EQ(k, 3);
+  EXPECT_NEAR(tr.getSegments()[1].v, 300, 0.5f); //< 手前で減速しきる
+  const auto last = tr.stateAt(tr.t_end());
+  EXPECT_NEAR(last.dq.x, 0, 1e-2f);
+  EXPECT_NEAR(last.dq.y, 0, 1e-2f);
+}
+
+TEST(Path, TurnVelocityCap) {
+  path::Trajectory tr;
+  /* 上限は v_max でも制限される */
+  EXPECT_TRUE(tr.reset({path::Motion::straight(720),
+                        path::Motion::turn(F90, false, 3000),
+                        path::Motion::straight(720)},
+                       240000, 3600, 1200));
+  EXPECT_NEAR(tr.getSegments()[1].v, 1200, 0.5f);
+  /* 始点速度が速すぎて減速しきれない */
+  EXPECT_FALSE(tr.reset({path::Motion::straight(10),
+                         path::Motion::turn(F90, false, 300)},
+                        240000, 3600, 2400, 2400));
+  EXPECT_GT(tr.getSegments()[1].v, 300);
+}
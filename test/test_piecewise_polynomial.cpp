@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/accel_designer.h>
+#include <ctrl/piecewise_polynomial.h>
+
+#include <random>
+
+using namespace ctrl;
+
+template <typename A, typename P> void testAgreement(const A &a, const P &p) {
+  /* error tolerance; rounding of the time offset is amplified by the jerk */
+  const float e = 1e-3f;
+  const auto near = [&](float x, float y) {
+    EXPECT_NEAR(x, y, e * (1 + std::abs(x)));
+  };
+  const auto ts = a.getTimeStamp();
+  const float Ts = (ts.back() - ts.front()) / 1e3f;
+  for (float t = ts.front() - Ts * 100; t < ts.back() + Ts * 100; t += Ts) {
+    near(p.a(t), a.a(t));
+    near(p.v(t), a.v(t));
+    near(p.x(t), a.x(t));
+  }
+  /* jerk is discontinuous at the boundaries */
+  for (std::size_t i = 1; i < ts.size(); ++i) {
+    const float t = (ts[i - 1] + ts[i]) / 2;
+    if (ts[i - 1] < t && t < ts[i])
+      near(p.j(t), a.j(t));
+  }
+  EXPECT_FLOAT_EQ(p.t_end(), a.t_end());
+  near(p.v_end(), a.v_end());
+  near(p.x_end(), a.x_end());
+}
+
+TEST(PiecewisePolynomial, AccelCurve) {
+  const std::vector<std::vector<float>> params = {
+      // jm, am, vs, ve
+      {100, 10, 0, 1}, {100, 10, 0, 2}, {100, 10, 1, 2},
+      {100, 10, 2, 1}, {100, 10, 2, 0}, {100, 10, 1, 0},
+  };
+  for (const auto &ps : params) {
+    const AccelCurve ac(ps[0], ps[1], ps[2], ps[3]);
+    testAgreement(ac, AccelCurvePolynomial(ac));
+  }
+}
+
+TEST(PiecewisePolynomial, AccelDesigner) {
+  std::mt19937 mt{std::random_device{}()};
+  std::uniform_real_distribution<float> j_urd(100, 1000);
+  std::uniform_real_distribution<float> a_urd(1, 10);
+  std::uniform_real_distribution<float> v_urd(0, 4);
+  std::uniform_real_distribution<float> d_urd(0.01, 4);
+  std::uniform_real_distribution<float> t_urd(-10, 10);
+  for (int i = 0; i < 100; ++i) {
+    const AccelDesigner ad(j_urd(mt), a_urd(mt), v_urd(mt), v_urd(mt),
+                           v_urd(mt), d_urd(mt), d_urd(mt), t_urd(mt));
+    testAgreement(ad, AccelDesignerPolynomial(ad));
+  }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/segment_queue.h>
+
+#include <thread>
+
+using namespace ctrl;
+
+TEST(SpscQueue, PushPop) {
+  SpscQueue<int, 4> q;
+  int v;
+  EXPECT_FALSE(q.pop(v));
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(q.push(i));
+  EXPECT_FALSE(q.push(4));
+  EXPECT_EQ(q.size(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(q.pop(v));
+    EXPECT_EQ(v, i);
+  }
+  EXPECT_FALSE(q.pop(v));
+}
+
+TEST(SegmentQueue, SeamlessHandover) {
+  const float jm = 240000, am = 3600, vm = 1200, Ts = 1e-3f;
+  const slalom::Shape shape(Pose(45, 45, M_PI / 2), 44);
+  /* 直線 -> スラローム -> 直線 (停止) */
+  const AccelDesigner ad1(jm, am, vm, 0, shape.v_ref, 180);
+  slalom::Trajectory st(shape);
+  st.reset(ad1.v_end());
+  const AccelDesigner ad2(jm, am, vm, ad1.v_end(), 0, 90);
+  SegmentQueue<4> sq;
+  EXPECT_FALSE(sq.advance(0));
+  EXPECT_TRUE(sq.push(ad1));
+  EXPECT_TRUE(sq.push(st));
+  EXPECT_TRUE(sq.push(ad2));
+  const float x_total =
+      180 + ad1.v_end() * st.getAccelDesigner().t_end() + ad2.x_end();
+  const float t_total = ad1.t_end() + st.getTimeCurve() + ad2.t_end();
+  float x_prev = 0;
+  const float t0 = 0.5f;
+  for (int k = 0; k * Ts < t_total; ++k) {
+    const float t = t0 + k * Ts;
+    ASSERT_TRUE(sq.advance(t));
+    /* 距離は連続で，1周期あたりの増分は速度の上限以下 */
+    const float x = sq.x(t);
+    EXPECT_GE(x, x_prev - 1e-3f);
+    EXPECT_LE(x - x_prev, vm * Ts + 1e-3f);
+    x_prev = x;
+  }
+  EXPECT_NEAR(sq.getTimeOffset(), t0 + ad1.t_end() + st.getTimeCurve(), 1e-5f);
+  EXPECT_NEAR(sq.x(t0 + t_total), x_total, 1e-2f);
+  EXPECT_EQ(sq.getCurrent().getType(), TrajectorySegment::Straight);
+  EXPECT_EQ(sq.getUnderruns(), 0u);
+}
+
+TEST(SegmentQueue, Underrun) {
+  const AccelDesigner ad(240000, 3600, 1200, 0, 600, 90);
+  SegmentQueue<2> sq;
+  sq.push(ad);
+  ASSERT_TRUE(sq.advance(0));
+  /* 次の区間が遅れる間は終点速度で外挿 */
+  const float t1 = ad.t_end() + 0.1f;
+  ASSERT_TRUE(sq.advance(t1));
+  EXPECT_EQ(sq.getUnderruns(), 1u);
+  EXPECT_NEAR(sq.x(t1), 90 + 60, 1e-2f);
+  const AccelDesigner ad2(240000, 3600, 1200, 600, 0, 90);
+  sq.push(ad2);
+  const float t2 = t1 + 1e-3f;
+  const float x2 = sq.x(t2);
+  ASSERT_TRUE(sq.advance(t2));
+  EXPECT_FLOAT_EQ(sq.getTimeOffset(), t2);
+  EXPECT_NEAR(sq.x(t2), x2, 1e-3f);
+  EXPECT_NEAR(sq.v(t2), 600, 1e-2f);
+  EXPECT_EQ(sq.getUnderruns(), 1u);
+}
+
+TEST(SegmentQueue, ProducerThread) {
+  SegmentQueue<8> sq;
+  const int n = 2000;
+  /* 区間の距離に通し番号を入れて順序を確認する */
+  std::thread producer([&] {
+    for (int i = 1; i <= n;)
+      if (sq.push(AccelDesigner(1e6f, 1e4f, 100, 100, 100, float(i))))
+        ++i;
+      else
+        std::this_thread::yield();
+  });
+  int received = 0;
+  float t = 0;
+  float x_expected = 0;
+  while (received < n) {
+    t += 1e-3f;
+    if (!sq.advance(t))
+      continue;
+    const auto &cur = sq.getCurrent();
+    if (cur.x_end() > float(received) + 0.5f) {
+      ++received;
+      EXPECT_NEAR(cur.x_end(), float(received), 1e-2f);
+    }
+    EXPECT_GE(sq.x(t), x_expected - 1);
+    x_expected = sq.x(t);
+  }
+  producer.join();
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/transform.h>
+
+#include <random>
+
+using namespace ctrl;
+
+TEST(Transform, AgreesWithPose) {
+  std::mt19937 mt{1};
+  std::uniform_real_distribution<float> urd(-1, 1);
+  Pose p;
+  Transform t;
+  for (int i = 0; i < 500; ++i) {
+    const Pose step(0.09f * urd(mt), 0.09f * urd(mt), 3.14f * urd(mt));
+    p = step.homogeneous(p);
+    t *= Transform(step);
+    t.normalize();
+    EXPECT_NEAR(t.x, p.x, 1e-3f);
+    EXPECT_NEAR(t.y, p.y, 1e-3f);
+    EXPECT_FLOAT_EQ(t.th, p.th);
+    EXPECT_NEAR(t.c, std::cos(p.th), 1e-4f);
+    EXPECT_NEAR(t.s, std::sin(p.th), 1e-4f);
+  }
+  const Pose q(0.01f, 0.02f, 0.3f);
+  const auto a = t.apply(q), b = q.homogeneous(t.toPose());
+  EXPECT_NEAR(a.x, b.x, 1e-4f);
+  EXPECT_NEAR(a.y, b.y, 1e-4f);
+  EXPECT_FLOAT_EQ(a.th, b.th);
+}
+
+TEST(Transform, Inverse) {
+  const Transform t(Pose(0.09f, -0.045f, 1.2f));
+  const auto i = t * t.inverse();
+  EXPECT_NEAR(i.x, 0, 1e-6f);
+  EXPECT_NEAR(i.y, 0, 1e-6f);
+  EXPECT_NEAR(i.th, 0, 1e-6f);
+  EXPECT_NEAR(i.c, 1, 1e-6f);
+  EXPECT_NEAR(i.s, 0, 1e-6f);
+  const auto p = t.inverse().apply(t.apply(Pose(0.1f, 0.2f, 0.3f)));
+  EXPECT_NEAR(p.x, 0.1f, 1e-6f);
+  EXPECT_NEAR(p.y, 0.2f, 1e-6f);
+  EXPECT_NEAR(p.th, 0.3f, 1e-6f);
+}
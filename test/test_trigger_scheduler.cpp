@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <ctrl/trigger_scheduler.h>
+
+#include <limits>
+#include <vector>
+
+using namespace ctrl;
+
+/**
+ * @brief fire triggers by the naive float comparison and by the scheduler
+ */
+void testFire(const AccelDesigner &ad, const std::vector<float> &xs,
+              const float Ts, const float t_origin) {
+  TriggerScheduler<8> ts;
+  EXPECT_TRUE(ts.reset(ad, xs.begin(), xs.end(), Ts, t_origin));
+  EXPECT_EQ(ts.pending(), xs.size());
+  const float s = ad.x_end() >= ad.x(ad.t_0()) ? 1 : -1;
+  std::vector<int> fired(xs.size(), -1);
+  std::vector<int> naive(xs.size(), -1);
+  const int ticks = std::ceil((ad.t_end() - t_origin) / Ts) + 10;
+  std::size_t next = 0;
+  int expected_index = 0;
+  for (int k = 0; k < ticks; ++k) {
+    for (int i; (i = ts.poll(k)) >= 0;) {
+      EXPECT_EQ(i, expected_index++); //< fired in order
+      fired[i] = k;
+    }
+    const auto x = ad.x(t_origin + k * Ts);
+    for (; next < xs.size() && s * (x - xs[next]) >= 0; ++next)
+      naive[next] = k;
+  }
+  EXPECT_EQ(ts.pending(), 0u);
+  EXPECT_EQ(ts.poll(ticks), -1);
+  for (std::size_t i = 0; i < xs.size(); ++i)
+    EXPECT_NEAR(fired[i], naive[i], 1); //< rounding at the tick boundary
+}
+
+TEST(TriggerScheduler, AccelDesigner) {
+  const float Ts = 1e-3f;
+  AccelDesigner ad(240000, 9000, 2.4f, 0.3f, 0.6f, 0.36f, 0.09f, 0.5f);
+  testFire(ad, {0.0f, 0.09f, 0.135f, 0.18f, 0.3f, 0.4f, 0.45f}, Ts, 0.5f);
+  testFire(ad, {0.2f}, Ts, 0.0f);
+  ad.reset(240000, 9000, 2.4f, -0.3f, -0.6f, -0.36f);
+  testFire(ad, {-0.045f, -0.09f, -0.36f}, Ts, 0.0f);
+}
+
+TEST(TriggerScheduler, SlalomTrajectory) {
+  const float Ts = 1e-3f;
+  const slalom::Shape shape(Pose(90, 90, M_PI / 2), 80, 0);
+  slalom::Trajectory st(shape);
+  st.reset(600);
+  TriggerScheduler<4> ts;
+  ts.reset(st, {float(M_PI / 4), float(M_PI / 2)}, Ts);
+  const auto &ad = st.getAccelDesigner();
+  int k = 0;
+  while (ts.poll(k) < 0)
+    ++k;
+  EXPECT_GE(ad.x(k * Ts), M_PI / 4 - 1e-3f);
+  EXPECT_LT(ad.x((k - 1) * Ts), M_PI / 4);
+  EXPECT_EQ(ts.pending(), 1u);
+}
+
+TEST(TriggerScheduler, Capacity) {
+  AccelDesigner ad(100, 10, 1, 0, 0, 1);
+  TriggerScheduler<2> ts;
+  EXPECT_FALSE(ts.reset(ad, {0.1f, 0.2f, 0.3f}, 1e-3f)); //< truncated
+  EXPECT_EQ(ts.pending(), 2u);
+  ts.clear();
+  EXPECT_EQ(ts.pending(), 0u);
+  EXPECT_EQ(ts.poll(std::numeric_limits<int32_t>::max() - 1), -1);
+  /* polling at the maximum tick must not run past the last trigger */
+  EXPECT_TRUE(ts.reset(ad, {0.1f, 0.2f}, 1e-3f));
+  const auto t_max = std::numeric_limits<int32_t>::max();
+  EXPECT_EQ(ts.poll(t_max), 0);
+  EXPECT_EQ(ts.poll(t_max), 1);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(ts.poll(t_max), -1);
+  EXPECT_EQ(ts.pending(), 0u);
+}
+
+TEST(TriggerScheduler, StopOutOfRange) {
+  const float Ts = 1e-3f;
+  AccelDesigner ad(100, 10, 1, 0, 0, 0.2f, 0.1f); //< stops at x = 0.3
+  ASSERT_EQ(ad.v_end(), 0);
+  TriggerScheduler<4> ts;
+  /* a trigger past the end is never reached, so it is not scheduled */
+  EXPECT_FALSE(ts.reset(ad, {0.15f, 0.3f, 0.35f}, Ts));
+  EXPECT_EQ(ts.pending(), 2u);
+  EXPECT_TRUE(ts.reset(ad, {0.1f, 0.3f}, Ts));
+  EXPECT_EQ(ts.pending(), 2u);
+  /* nor is a trigger behind the start */
+  EXPECT_FALSE(ts.reset(ad, {0.05f, 0.2f}, Ts));
+  EXPECT_EQ(ts.pending(), 0u);
+  /* backward profile */
+  AccelDesigner bd(100, 10, 1, 0, 0, -0.2f);
+  EXPECT_TRUE(ts.reset(bd, {-0.1f, -0.2f}, Ts));
+  EXPECT_FALSE(ts.reset(bd, {-0.1f, -0.25f}, Ts));
+  EXPECT_EQ(ts.pending(), 1u);
+}
+
+TEST(TriggerScheduler, TickRange) {
+  AccelDesigner ad(100, 10, 1, 0.5f, 0.5f, 1); //< keeps moving at the end
+  TriggerScheduler<2> ts;
+  /* a tiny period overflows the tick, which saturates instead */
+  EXPECT_TRUE(ts.reset(ad, {0.5f, 1.0f}, 1e-12f));
+  EXPECT_EQ(ts.getTick(0), std::numeric_limits<int32_t>::max());
+  EXPECT_TRUE(ts.reset(ad, {0.5f}, 1e-12f, 1e3f));
+  EXPECT_EQ(ts.getTick(0), std::numeric_limits<int32_t>::min());
+}